@@ -0,0 +1,234 @@
+#include "arbitrary-checkpoint.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RECORD_MAGIC UINT32_C(0x4b434e41)  // "ANCK"
+#define RECORD_VERSION 1
+#define PAYLOAD_MAX 512
+
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t arbitrary_checkpoint_hash(uint64_t hash, const void* data, size_t len) {
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+// === Record encoding ===
+
+// Incumbent values are stored in ArbitraryNumber binary form
+static size_t put_rational(uint8_t* buf, size_t capacity, ArbitraryRational value) {
+    ArbitraryNumber* num = arbitrary_create();
+    arbitrary_add_term(num, 1, value.num, value.den);
+    size_t size = arbitrary_serialize(num, buf, capacity);
+    arbitrary_free(num);
+    return size;
+}
+
+static size_t get_rational(const uint8_t* buf, size_t len, ArbitraryRational* value) {
+    size_t consumed = 0;
+    ArbitraryNumber* num = arbitrary_deserialize(buf, len, &consumed);
+    if (!num) return 0;
+    bool ok = arbitrary_evaluate(num, value);
+    arbitrary_free(num);
+    return ok ? consumed : 0;
+}
+
+#define FIXED_SIZE (5 + 4 * 8 + 3 * ARBITRARY_PERM_MAX)
+
+static size_t encode_checkpoint(const ArbitraryCheckpoint* cp, uint8_t* buf) {
+    buf[0] = RECORD_VERSION;
+    buf[1] = (uint8_t)cp->kind;
+    buf[2] = cp->found;
+    buf[3] = (uint8_t)cp->perm.n;
+    buf[4] = (uint8_t)cp->perm.k;
+    uint8_t* p = buf + 5;
+    arbitrary_put_u64(p, cp->instance_hash);
+    arbitrary_put_u64(p + 8, cp->nodes_explored);
+    arbitrary_put_u64(p + 16, cp->rank);
+    arbitrary_put_u64(p + 24, cp->best_mask);
+    p += 32;
+    for (int i = 0; i < ARBITRARY_PERM_MAX; i++) {
+        p[i] = (uint8_t)cp->perm.perm[i];
+        p[ARBITRARY_PERM_MAX + i] = (uint8_t)cp->perm.c[i];
+        p[2 * ARBITRARY_PERM_MAX + i] = (uint8_t)cp->best_perm[i];
+    }
+
+    size_t size = FIXED_SIZE;
+    size_t best = put_rational(buf + size, PAYLOAD_MAX - size, cp->best);
+    size += best;
+    size_t gap = put_rational(buf + size, PAYLOAD_MAX - size, cp->bound_gap);
+    return (best && gap) ? size + gap : 0;
+}
+
+static bool is_permutation(const int* perm, int n) {
+    bool seen[ARBITRARY_PERM_MAX] = {false};
+    for (int i = 0; i < n; i++) {
+        if (perm[i] < 0 || perm[i] >= n || seen[perm[i]]) return false;
+        seen[perm[i]] = true;
+    }
+    return true;
+}
+
+// A QAP record drives array indexing on resume, so its Heap state must be
+// one the iterator could actually have reached
+static bool valid_perm_state(const ArbitraryCheckpoint* cp) {
+    const ArbitraryPermIter* it = &cp->perm;
+    if (it->n < 1 || it->k < 1 || it->k > it->n) return false;
+    if (!is_permutation(it->perm, it->n)) return false;
+    if (cp->found && !is_permutation(cp->best_perm, it->n)) return false;
+    for (int i = 0; i < it->n; i++) {
+        if (it->c[i] > i) return false;
+    }
+    return true;
+}
+
+static bool decode_checkpoint(const uint8_t* buf, size_t len, ArbitraryCheckpoint* cp) {
+    if (len < FIXED_SIZE || buf[0] != RECORD_VERSION) return false;
+    memset(cp, 0, sizeof(*cp));
+    cp->kind = (ArbitraryCheckpointKind)buf[1];
+    cp->found = buf[2];
+    cp->perm.n = buf[3];
+    cp->perm.k = buf[4];
+    if (cp->perm.n > ARBITRARY_PERM_MAX) return false;
+
+    const uint8_t* p = buf + 5;
+    cp->instance_hash = arbitrary_get_u64(p);
+    cp->nodes_explored = arbitrary_get_u64(p + 8);
+    cp->rank = arbitrary_get_u64(p + 16);
+    cp->best_mask = arbitrary_get_u64(p + 24);
+    p += 32;
+    for (int i = 0; i < ARBITRARY_PERM_MAX; i++) {
+        cp->perm.perm[i] = p[i];
+        cp->perm.c[i] = p[ARBITRARY_PERM_MAX + i];
+        cp->best_perm[i] = p[2 * ARBITRARY_PERM_MAX + i];
+    }
+
+    if (cp->kind == ARBITRARY_CHECKPOINT_QAP) {
+        if (!valid_perm_state(cp)) return false;
+    } else if (cp->kind != ARBITRARY_CHECKPOINT_SUBSET_SUM) {
+        return false;
+    }
+
+    size_t size = FIXED_SIZE;
+    size_t best = get_rational(buf + size, len - size, &cp->best);
+    if (!best) return false;
+    size += best;
+    return get_rational(buf + size, len - size, &cp->bound_gap) != 0;
+}
+
+// === Log file ===
+
+// Scans the log from the start, keeping in out the last valid record that
+// matches kind and instance_hash (any record when kind is 0). Returns the
+// offset where valid data ends so a torn tail can be truncated.
+static long scan_records(FILE* file, ArbitraryCheckpointKind kind, uint64_t instance_hash,
+                         ArbitraryCheckpoint* out, bool* found) {
+    uint8_t header[8];
+    uint8_t payload[PAYLOAD_MAX];
+    uint8_t checksum[4];
+    long valid_end = 0;
+
+    rewind(file);
+    while (fread(header, 1, sizeof(header), file) == sizeof(header)) {
+        uint32_t len = arbitrary_get_u32(header + 4);
+        if (arbitrary_get_u32(header) != RECORD_MAGIC || len > PAYLOAD_MAX) break;
+        if (fread(payload, 1, len, file) != len) break;
+        if (fread(checksum, 1, sizeof(checksum), file) != sizeof(checksum)) break;
+        if (arbitrary_get_u32(checksum) != (uint32_t)arbitrary_checkpoint_hash(ARBITRARY_CHECKPOINT_HASH_SEED, payload, len)) break;
+
+        ArbitraryCheckpoint cp;
+        if (!decode_checkpoint(payload, len, &cp)) break;
+        valid_end = ftell(file);
+        if (kind == 0 || (cp.kind == kind && cp.instance_hash == instance_hash)) {
+            *out = cp;
+            *found = true;
+        }
+    }
+    return valid_end;
+}
+
+ArbitraryCheckpointLog* arbitrary_checkpoint_open(const char* path, double interval_seconds) {
+    FILE* file = fopen(path, "a+b");
+    if (!file) {
+        fprintf(stderr, "Error: cannot open checkpoint log %s.\n", path);
+        return NULL;
+    }
+
+    ArbitraryCheckpointLog* log = calloc(1, sizeof(ArbitraryCheckpointLog));
+    if (!log) {
+        fclose(file);
+        return NULL;
+    }
+    log->file = file;
+    log->interval_seconds = interval_seconds;
+
+    long valid_end = scan_records(file, 0, 0, &log->last, &log->has_last);
+    fflush(file);
+    if (ftruncate(fileno(file), valid_end) != 0) {
+        fprintf(stderr, "Error: cannot truncate torn checkpoint log %s.\n", path);
+    }
+    fseek(file, 0, SEEK_END);
+
+    log->last_write = monotonic_seconds();
+    return log;
+}
+
+void arbitrary_checkpoint_close(ArbitraryCheckpointLog* log) {
+    if (log) {
+        fclose(log->file);
+        free(log);
+    }
+}
+
+bool arbitrary_checkpoint_resume(const ArbitraryCheckpointLog* log, ArbitraryCheckpointKind kind,
+                                 uint64_t instance_hash, ArbitraryCheckpoint* out) {
+    if (!log || !log->has_last) return false;
+    if (log->last.kind == kind && log->last.instance_hash == instance_hash) {
+        *out = log->last;
+        return true;
+    }
+
+    // Another instance wrote last; look further back for this one's progress
+    bool found = false;
+    scan_records(log->file, kind, instance_hash, out, &found);
+    fseek(log->file, 0, SEEK_END);
+    return found;
+}
+
+bool arbitrary_checkpoint_due(const ArbitraryCheckpointLog* log) {
+    return log && monotonic_seconds() - log->last_write >= log->interval_seconds;
+}
+
+bool arbitrary_checkpoint_write(ArbitraryCheckpointLog* log, const ArbitraryCheckpoint* checkpoint) {
+    uint8_t record[8 + PAYLOAD_MAX + 4];
+    size_t len = encode_checkpoint(checkpoint, record + 8);
+    if (len == 0) return false;
+
+    arbitrary_put_u32(record, RECORD_MAGIC);
+    arbitrary_put_u32(record + 4, (uint32_t)len);
+    arbitrary_put_u32(record + 8 + len, (uint32_t)arbitrary_checkpoint_hash(ARBITRARY_CHECKPOINT_HASH_SEED, record + 8, len));
+
+    // One write per record, then force it to disk before reporting success
+    size_t size = 8 + len + 4;
+    bool ok = fwrite(record, 1, size, log->file) == size &&
+              fflush(log->file) == 0 &&
+              fsync(fileno(log->file)) == 0;
+    log->last_write = monotonic_seconds();
+    if (ok) {
+        log->last = *checkpoint;
+        log->has_last = true;
+    } else {
+        fprintf(stderr, "Error: failed to append checkpoint.\n");
+    }
+    return ok;
+}
@@ -0,0 +1,61 @@
+#ifndef ARBITRARY_CHECKPOINT_H
+#define ARBITRARY_CHECKPOINT_H
+
+#include <stdio.h>
+#include "arbitrary-number.h"
+#include "arbitrary-enumerate.h"
+
+// === Checkpoint/restart for exhaustive searches ===
+// Checkpoints are appended to a log file as self-checking records (length
+// plus checksum) and each append is fsync'ed. On open, the last complete
+// record is loaded and any torn tail left by a crash is cut off, so a
+// resume always starts from a consistent state. Several instances may
+// share one log; each resumes from its own most recent record.
+//
+// Writes happen at most once per interval; with the solvers' polling every
+// ARBITRARY_SOLVE_POLL_INTERVAL nodes an interval of a few seconds or more
+// keeps the overhead well under 1% of the runtime.
+
+typedef enum {
+    ARBITRARY_CHECKPOINT_SUBSET_SUM = 1,
+    ARBITRARY_CHECKPOINT_QAP = 2
+} ArbitraryCheckpointKind;
+
+typedef struct {
+    ArbitraryCheckpointKind kind;
+    uint64_t instance_hash;   // Guards against resuming a different instance
+    uint64_t nodes_explored;
+    uint64_t rank;            // Subset-sum: Gray rank of the last visited subset
+    ArbitraryPermIter perm;   // QAP: iterator positioned on the last visited permutation
+    bool found;
+    ArbitraryRational best;
+    ArbitraryRational bound_gap;
+    uint64_t best_mask;
+    int best_perm[ARBITRARY_PERM_MAX];
+} ArbitraryCheckpoint;
+
+typedef struct {
+    FILE* file;
+    double interval_seconds;
+    double last_write;        // Monotonic time of the last append
+    bool has_last;
+    ArbitraryCheckpoint last; // Most recent valid record in the log
+} ArbitraryCheckpointLog;
+
+// Opens (or creates) the log and loads its last valid record. Returns NULL
+// if the file cannot be opened or the log cannot be allocated.
+ArbitraryCheckpointLog* arbitrary_checkpoint_open(const char* path, double interval_seconds);
+void arbitrary_checkpoint_close(ArbitraryCheckpointLog* log);
+
+// Copies the most recent record for kind and instance_hash into out,
+// searching past records of other instances. Returns false if there is none.
+bool arbitrary_checkpoint_resume(const ArbitraryCheckpointLog* log, ArbitraryCheckpointKind kind,
+                                 uint64_t instance_hash, ArbitraryCheckpoint* out);
+bool arbitrary_checkpoint_due(const ArbitraryCheckpointLog* log);
+bool arbitrary_checkpoint_write(ArbitraryCheckpointLog* log, const ArbitraryCheckpoint* checkpoint);
+
+// FNV-1a, chained through hash; start from ARBITRARY_CHECKPOINT_HASH_SEED
+#define ARBITRARY_CHECKPOINT_HASH_SEED UINT64_C(0xcbf29ce484222325)
+uint64_t arbitrary_checkpoint_hash(uint64_t hash, const void* data, size_t len);
+
+#endif
@@ -0,0 +1,100 @@
+#include "arbitrary-enumerate.h"
+#include <stdio.h>
+
+uint64_t arbitrary_gray_code(uint64_t rank) {
+    return rank ^ (rank >> 1);
+}
+
+bool arbitrary_subset_iter_init(ArbitrarySubsetIter* it, int n, uint64_t begin, uint64_t end) {
+    bool valid = n >= 0 && n <= ARBITRARY_SUBSET_MAX;
+    uint64_t total = 0;
+    if (!valid) {
+        fprintf(stderr, "Error: subset enumeration supports at most %d elements.\n", ARBITRARY_SUBSET_MAX);
+    } else {
+        total = UINT64_C(1) << n;
+    }
+    if (end > total) end = total;
+    if (begin > end) begin = end;
+
+    it->n = n;
+    it->rank = begin;
+    it->end = end;
+    it->mask = arbitrary_gray_code(begin);
+    return valid;
+}
+
+bool arbitrary_subset_iter_next(ArbitrarySubsetIter* it, ArbitrarySubsetDelta* delta) {
+    if (it->rank + 1 >= it->end) return false;
+
+    // Going from rank r to r + 1 flips the bit at the lowest set bit of r + 1
+    it->rank++;
+    int index = __builtin_ctzll(it->rank);
+    it->mask ^= UINT64_C(1) << index;
+
+    delta->index = index;
+    delta->added = (it->mask >> index) & 1;
+    return true;
+}
+
+void arbitrary_enumerate_subsets(int n,
+                                 void (*callback)(uint64_t mask, const ArbitrarySubsetDelta* delta, void* user_data),
+                                 void* user_data) {
+    ArbitrarySubsetIter it;
+    ArbitrarySubsetDelta delta;
+
+    if (!arbitrary_subset_iter_init(&it, n, 0, UINT64_MAX)) return;
+    while (arbitrary_subset_iter_next(&it, &delta)) {
+        callback(it.mask, &delta, user_data);
+    }
+}
+
+bool arbitrary_perm_iter_init(ArbitraryPermIter* it, int n) {
+    bool valid = n >= 0 && n <= ARBITRARY_PERM_MAX;
+    if (!valid) {
+        fprintf(stderr, "Error: permutation enumeration supports at most %d elements.\n", ARBITRARY_PERM_MAX);
+        n = 0;
+    }
+    it->n = n;
+    for (int i = 0; i < n; i++) {
+        it->perm[i] = i;
+        it->c[i] = 0;
+    }
+    it->k = 1;
+    return valid;
+}
+
+// Iterative form of Heap's algorithm, resumable from any (c, k) state
+bool arbitrary_perm_iter_next(ArbitraryPermIter* it, ArbitraryPermDelta* delta) {
+    while (it->k < it->n) {
+        if (it->c[it->k] < it->k) {
+            int i = (it->k % 2 == 0) ? 0 : it->c[it->k];
+            int j = it->k;
+            int tmp = it->perm[i];
+            it->perm[i] = it->perm[j];
+            it->perm[j] = tmp;
+
+            it->c[it->k]++;
+            it->k = 1;
+
+            delta->i = i;
+            delta->j = j;
+            return true;
+        }
+        it->c[it->k] = 0;
+        it->k++;
+    }
+    return false;
+}
+
+void arbitrary_enumerate_permutations(int n,
+                                      void (*callback)(const int* perm, int n, const ArbitraryPermDelta* delta, void* user_data),
+                                      void* user_data) {
+    ArbitraryPermIter it;
+    ArbitraryPermDelta delta;
+
+    if (!arbitrary_perm_iter_init(&it, n)) return;
+    callback(it.perm, it.n, NULL, user_data);
+    while (arbitrary_perm_iter_next(&it, &delta)) {
+        callback(it.perm, it.n, &delta, user_data);
+    }
+}
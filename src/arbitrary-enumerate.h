@@ -0,0 +1,67 @@
+#ifndef ARBITRARY_ENUMERATE_H
+#define ARBITRARY_ENUMERATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ARBITRARY_SUBSET_MAX 63  // Subsets are held in a uint64_t mask
+#define ARBITRARY_PERM_MAX 16    // Beyond this exhaustive search is hopeless anyway
+
+// === Subsets in binary reflected Gray-code order ===
+// Consecutive subsets differ by exactly one element, so a running sum can be
+// updated with a single add or subtract instead of being rebuilt per mask.
+
+typedef struct {
+    int index;   // Element toggled by this step
+    bool added;  // true if the element entered the subset, false if it left
+} ArbitrarySubsetDelta;
+
+typedef struct {
+    int n;
+    uint64_t rank;  // Position in Gray order of the current subset
+    uint64_t end;   // One past the last rank to visit
+    uint64_t mask;  // Current subset (bit i set = element i selected)
+} ArbitrarySubsetIter;
+
+uint64_t arbitrary_gray_code(uint64_t rank);
+
+// Positions the iterator on the subset at rank `begin`; the caller accounts
+// for that starting subset (the empty set when begin == 0). Returns false,
+// leaving an empty range, if n is outside 0..ARBITRARY_SUBSET_MAX.
+bool arbitrary_subset_iter_init(ArbitrarySubsetIter* it, int n, uint64_t begin, uint64_t end);
+bool arbitrary_subset_iter_next(ArbitrarySubsetIter* it, ArbitrarySubsetDelta* delta);
+
+// Visits every non-empty subset of n elements, starting from the empty set.
+// Nothing is visited if n is out of range.
+void arbitrary_enumerate_subsets(int n,
+                                 void (*callback)(uint64_t mask, const ArbitrarySubsetDelta* delta, void* user_data),
+                                 void* user_data);
+
+// === Permutations in Heap's order ===
+// Consecutive permutations differ by a single swap of two positions, so a
+// cost only needs the terms touching those positions recomputed.
+
+typedef struct {
+    int i;  // Positions swapped by this step
+    int j;
+} ArbitraryPermDelta;
+
+typedef struct {
+    int n;
+    int perm[ARBITRARY_PERM_MAX];
+    int c[ARBITRARY_PERM_MAX];  // Heap's algorithm loop counters
+    int k;                      // Current level of the iterative loop
+} ArbitraryPermIter;
+
+// Positions the iterator on the identity permutation. Returns false, leaving
+// no permutations to visit, if n is outside 0..ARBITRARY_PERM_MAX.
+bool arbitrary_perm_iter_init(ArbitraryPermIter* it, int n);
+bool arbitrary_perm_iter_next(ArbitraryPermIter* it, ArbitraryPermDelta* delta);
+
+// Visits all n! permutations; delta is NULL for the first (identity) one.
+// Nothing is visited if n is out of range.
+void arbitrary_enumerate_permutations(int n,
+                                      void (*callback)(const int* perm, int n, const ArbitraryPermDelta* delta, void* user_data),
+                                      void* user_data);
+
+#endif
@@ -0,0 +1,160 @@
+#include "arbitrary-filter.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+// Stage one compares FILTER_LANE_WIDTH subsets at once using GCC vector
+// types sized to the target's SIMD registers. GCC scalarizes compares on
+// vectors wider than the hardware, so the width follows -march.
+#if defined(__AVX__)
+#define FILTER_LANE_WIDTH 4
+#else
+#define FILTER_LANE_WIDTH 2  // SSE2, NEON
+#endif
+typedef double FilterLanes __attribute__((vector_size(FILTER_LANE_WIDTH * sizeof(double))));
+typedef int64_t FilterHits __attribute__((vector_size(FILTER_LANE_WIDTH * sizeof(int64_t))));
+
+// Nearest double to num/den: converting num, converting den and dividing each
+// round once, so the relative error is below 2 * DBL_EPSILON.
+static double rational_approx(ArbitraryRational r) {
+    return (double)r.num / (double)r.den;
+}
+
+ArbitraryMatchFilter* arbitrary_filter_create(ArbitraryNumber* const* weights, int n,
+                                              const ArbitraryNumber* target,
+                                              const ArbitraryNumber* tolerance) {
+    if (n < 1 || n > ARBITRARY_SUBSET_MAX) {
+        fprintf(stderr, "Error: filter supports between 1 and %d weights.\n", ARBITRARY_SUBSET_MAX);
+        return NULL;
+    }
+
+    ArbitraryMatchFilter* filter = malloc(sizeof(ArbitraryMatchFilter));
+    if (!filter) return NULL;
+    filter->n = n;
+    filter->tolerance = (ArbitraryRational){0, 1};
+
+    bool ok = arbitrary_evaluate(target, &filter->target);
+    if (tolerance) ok = ok && arbitrary_evaluate(tolerance, &filter->tolerance);
+    for (int i = 0; ok && i < n; i++) {
+        ok = arbitrary_evaluate(weights[i], &filter->values[i]);
+    }
+    if (!ok || filter->tolerance.num == INT64_MIN) {
+        // INT64_MIN has no 64-bit magnitude, so it cannot serve as a tolerance
+        fprintf(stderr, "Error: filter input does not fit in a 64-bit rational.\n");
+        free(filter);
+        return NULL;
+    }
+    if (filter->tolerance.num < 0) filter->tolerance.num = -filter->tolerance.num;
+
+    // Every subset sum is accumulated with at most n + 1 roundings over
+    // values bounded by abs_total, and each input carries at most
+    // 2 * DBL_EPSILON relative error; doubling the resulting first-order
+    // bound absorbs the higher-order terms and the final compare.
+    double abs_total = 0.0;
+    for (int i = 0; i < n; i++) {
+        filter->approx[i] = rational_approx(filter->values[i]);
+        abs_total += fabs(filter->approx[i]);
+    }
+    filter->target_approx = rational_approx(filter->target);
+    double tolerance_approx = rational_approx(filter->tolerance);
+    double magnitude = abs_total + fabs(filter->target_approx) + tolerance_approx;
+    double error_bound = 2.0 * (n + 6) * DBL_EPSILON * magnitude;
+    filter->threshold = (tolerance_approx + error_bound) * (1.0 + 4 * DBL_EPSILON);
+
+    filter->lane_bits = n < ARBITRARY_FILTER_LANE_BITS ? n : ARBITRARY_FILTER_LANE_BITS;
+    size_t lanes = (size_t)1 << filter->lane_bits;
+    size_t padded = lanes < FILTER_LANE_WIDTH ? FILTER_LANE_WIDTH : lanes;
+    filter->lane_sums = malloc(sizeof(double) * padded);
+    if (!filter->lane_sums) {
+        free(filter);
+        return NULL;
+    }
+    filter->lane_sums[0] = 0.0;
+    for (size_t j = 1; j < lanes; j++) {
+        int top = 63 - __builtin_clzll(j);
+        filter->lane_sums[j] = filter->lane_sums[j ^ ((size_t)1 << top)] + filter->approx[top];
+    }
+    // Padding lanes fill out the last vector; NaN never passes the compare
+    for (size_t j = lanes; j < padded; j++) filter->lane_sums[j] = NAN;
+
+    return filter;
+}
+
+void arbitrary_filter_free(ArbitraryMatchFilter* filter) {
+    if (filter) {
+        free(filter->lane_sums);
+        free(filter);
+    }
+}
+
+// Stage two: exact |sum - target| <= tolerance for a single candidate
+static void filter_check_exact(const ArbitraryMatchFilter* filter, uint64_t mask,
+                               void (*callback)(uint64_t, const ArbitraryRational*, void*),
+                               void* user_data, ArbitraryFilterStats* stats) {
+    ArbitraryRational sum = {0, 1};
+    for (int i = 0; i < filter->n; i++) {
+        if ((mask >> i) & 1) {
+            if (!arbitrary_rational_add(&sum, filter->values[i])) {
+                stats->overflows++;
+                callback(mask, NULL, user_data);
+                return;
+            }
+        }
+    }
+
+    ArbitraryRational diff = sum;
+    if (!arbitrary_rational_sub(&diff, filter->target)) {
+        stats->overflows++;
+        callback(mask, NULL, user_data);
+        return;
+    }
+
+    ArbitraryRational lower = {-filter->tolerance.num, filter->tolerance.den};
+    if (arbitrary_rational_compare(diff, lower) >= 0 &&
+        arbitrary_rational_compare(diff, filter->tolerance) <= 0) {
+        stats->matches++;
+        callback(mask, &sum, user_data);
+    }
+}
+
+void arbitrary_filter_run(const ArbitraryMatchFilter* filter,
+                          void (*callback)(uint64_t mask, const ArbitraryRational* sum, void* user_data),
+                          void* user_data, ArbitraryFilterStats* stats) {
+    ArbitraryFilterStats local = {0};
+    int lane_bits = filter->lane_bits;
+    size_t lanes = (size_t)1 << lane_bits;
+    uint64_t high_count = UINT64_C(1) << (filter->n - lane_bits);
+    FilterLanes threshold = (FilterLanes){0} + filter->threshold;
+
+    for (uint64_t high = 0; high < high_count; high++) {
+        double high_sum = 0.0;
+        for (int i = lane_bits; i < filter->n; i++) {
+            if ((high >> (i - lane_bits)) & 1) high_sum += filter->approx[i];
+        }
+
+        // Stage one: |high_sum + lane_sum - target| <= threshold, one vector at a time
+        for (size_t base = 0; base < lanes; base += FILTER_LANE_WIDTH) {
+            FilterLanes diff;
+            memcpy(&diff, filter->lane_sums + base, sizeof(diff));
+            diff = (high_sum + diff) - filter->target_approx;
+            FilterHits hit = (diff <= threshold) & (-diff <= threshold);
+
+            FilterHits any = hit;
+            for (int j = 1; j < FILTER_LANE_WIDTH; j++) any[0] |= hit[j];
+            if (!any[0]) continue;
+
+            for (int j = 0; j < FILTER_LANE_WIDTH; j++) {
+                if (!hit[j]) continue;
+                uint64_t mask = (high << lane_bits) | (base + j);
+                if (mask == 0) continue;
+                local.passed++;
+                filter_check_exact(filter, mask, callback, user_data, &local);
+            }
+        }
+    }
+
+    local.candidates = (high_count << lane_bits) - 1;
+    if (stats) *stats = local;
+}
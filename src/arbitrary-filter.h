@@ -0,0 +1,50 @@
+#ifndef ARBITRARY_FILTER_H
+#define ARBITRARY_FILTER_H
+
+#include "arbitrary-number.h"
+#include "arbitrary-enumerate.h"
+
+// === Approximate-first subset matching ===
+// Stage one sums double approximations of the weights, several subsets per
+// SIMD compare, and keeps only subsets whose distance to the target is
+// within the tolerance plus a certified rounding bound. Stage two re-checks
+// those few candidates with exact rational arithmetic, so no false match is
+// reported. A candidate whose exact sum does not fit in 64 bits cannot be
+// decided; it is passed to the callback with a NULL sum rather than dropped.
+
+#define ARBITRARY_FILTER_LANE_BITS 10  // Low mask bits handled by one batch
+
+typedef struct {
+    uint64_t candidates;  // Subsets scanned by stage one
+    uint64_t passed;      // Subsets inside the error band, checked exactly
+    uint64_t matches;     // Subsets with |sum - target| <= tolerance
+    uint64_t overflows;   // Candidates whose exact sum did not fit in 64 bits (undecided)
+} ArbitraryFilterStats;
+
+typedef struct {
+    int n;
+    ArbitraryRational values[ARBITRARY_SUBSET_MAX];
+    double approx[ARBITRARY_SUBSET_MAX];
+    ArbitraryRational target;
+    ArbitraryRational tolerance;
+    double target_approx;
+    double threshold;  // Stage-one pass band: tolerance plus error bound
+    int lane_bits;
+    double* lane_sums; // Approximate sums of every subset of the low lane_bits weights
+} ArbitraryMatchFilter;
+
+// tolerance may be NULL for exact equality. Returns NULL if an input has no
+// 64-bit rational value or n is out of range.
+ArbitraryMatchFilter* arbitrary_filter_create(ArbitraryNumber* const* weights, int n,
+                                              const ArbitraryNumber* target,
+                                              const ArbitraryNumber* tolerance);
+void arbitrary_filter_free(ArbitraryMatchFilter* filter);
+
+// Streams every non-empty subset with |sum - target| <= tolerance to the
+// callback, along with its exact sum. Undecided candidates follow with
+// sum == NULL. stats may be NULL.
+void arbitrary_filter_run(const ArbitraryMatchFilter* filter,
+                          void (*callback)(uint64_t mask, const ArbitraryRational* sum, void* user_data),
+                          void* user_data, ArbitraryFilterStats* stats);
+
+#endif
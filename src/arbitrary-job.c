@@ -0,0 +1,277 @@
+#include "arbitrary-job.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+    JOB_SUBSET_SUM,
+    JOB_QAP
+} JobKind;
+
+struct ArbitraryJob {
+    JobKind kind;
+    union {
+        ArbitrarySubsetSumInstance subset_sum;
+        ArbitraryQAPInstance qap;
+    } instance;
+    ArbitraryJobCallback callback;
+    void* user_data;
+    char* checkpoint_path;    // Optional checkpoint log, opened while the job runs
+    ArbitrarySearchControl control;
+    ArbitrarySolveResult result;
+    ArbitraryJobPool* pool;
+    ArbitraryJobState state;  // Guarded by pool->lock
+    int refs;                 // Guarded by pool->lock: one for the caller, one for the pool
+    ArbitraryJob* next;       // Queue link
+};
+
+typedef struct {
+    ArbitraryJobPool* pool;
+    int index;
+} JobWorker;
+
+struct ArbitraryJobPool {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t job_finished;
+    ArbitraryJob* head;
+    ArbitraryJob* tail;
+    ArbitraryJob** running;  // Job held by each worker, or NULL
+    bool shutting_down;
+    int thread_count;
+    pthread_t* threads;
+    JobWorker* workers;
+};
+
+static void job_free(ArbitraryJob* job) {
+    arbitrary_search_control_destroy(&job->control);
+    free(job->checkpoint_path);
+    free(job);
+}
+
+// Drops one reference; caller holds pool->lock
+static bool job_unref_locked(ArbitraryJob* job) {
+    return --job->refs == 0;
+}
+
+static void job_run(ArbitraryJob* job) {
+    if (atomic_load(&job->control.cancel_requested)) {
+        memset(&job->result, 0, sizeof(job->result));
+        job->result.status = ARBITRARY_SOLVE_CANCELLED;
+    } else {
+        // A log that cannot be opened is reported and the job runs without it
+        if (job->checkpoint_path) {
+            job->control.checkpoint = arbitrary_checkpoint_open(job->checkpoint_path,
+                                                                ARBITRARY_JOB_CHECKPOINT_INTERVAL);
+        }
+        if (job->kind == JOB_SUBSET_SUM) {
+            arbitrary_solve_subset_sum(&job->instance.subset_sum, &job->control, &job->result);
+        } else {
+            arbitrary_solve_qap(&job->instance.qap, &job->control, &job->result);
+        }
+        arbitrary_checkpoint_close(job->control.checkpoint);
+        job->control.checkpoint = NULL;
+    }
+
+    if (job->callback) job->callback(job, &job->result, job->user_data);
+}
+
+static void* job_worker_main(void* arg) {
+    JobWorker* worker = arg;
+    ArbitraryJobPool* pool = worker->pool;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->head && !pool->shutting_down) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (!pool->head) break;
+
+        ArbitraryJob* job = pool->head;
+        pool->head = job->next;
+        if (!pool->head) pool->tail = NULL;
+        job->state = ARBITRARY_JOB_RUNNING;
+        pool->running[worker->index] = job;
+        pthread_mutex_unlock(&pool->lock);
+
+        job_run(job);
+
+        pthread_mutex_lock(&pool->lock);
+        job->state = ARBITRARY_JOB_FINISHED;
+        pool->running[worker->index] = NULL;
+        pthread_cond_broadcast(&pool->job_finished);
+        if (job_unref_locked(job)) job_free(job);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ArbitraryJobPool* arbitrary_job_pool_create(int threads) {
+    if (threads < 1) {
+        fprintf(stderr, "Error: job pool needs at least one thread.\n");
+        return NULL;
+    }
+
+    ArbitraryJobPool* pool = calloc(1, sizeof(ArbitraryJobPool));
+    if (!pool) return NULL;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->job_finished, NULL);
+    pool->running = calloc(threads, sizeof(ArbitraryJob*));
+    pool->threads = malloc(sizeof(pthread_t) * threads);
+    pool->workers = malloc(sizeof(JobWorker) * threads);
+    if (!pool->running || !pool->threads || !pool->workers) {
+        arbitrary_job_pool_free(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < threads; i++) {
+        pool->workers[i] = (JobWorker){pool, i};
+        if (pthread_create(&pool->threads[i], NULL, job_worker_main, &pool->workers[i]) != 0) {
+            fprintf(stderr, "Error: could not start job worker thread.\n");
+            break;
+        }
+        pool->thread_count++;
+    }
+    if (pool->thread_count == 0) {
+        arbitrary_job_pool_free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void arbitrary_job_pool_free(ArbitraryJobPool* pool) {
+    if (!pool) return;
+
+    // Workers drain the queue before exiting; cancelled jobs finish at once
+    pthread_mutex_lock(&pool->lock);
+    pool->shutting_down = true;
+    for (ArbitraryJob* job = pool->head; job; job = job->next) {
+        atomic_store(&job->control.cancel_requested, true);
+    }
+    for (int i = 0; i < pool->thread_count; i++) {
+        if (pool->running[i]) atomic_store(&pool->running[i]->control.cancel_requested, true);
+    }
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->job_finished);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool->running);
+    free(pool);
+}
+
+static ArbitraryJob* job_submit(ArbitraryJobPool* pool, ArbitraryJob* job, const char* checkpoint_path,
+                                ArbitraryJobCallback callback, void* user_data) {
+    if (!job) return NULL;
+    job->checkpoint_path = NULL;
+    if (checkpoint_path) {
+        size_t len = strlen(checkpoint_path) + 1;
+        job->checkpoint_path = malloc(len);
+        if (!job->checkpoint_path) {
+            free(job);
+            return NULL;
+        }
+        memcpy(job->checkpoint_path, checkpoint_path, len);
+    }
+    job->callback = callback;
+    job->user_data = user_data;
+    job->pool = pool;
+    job->state = ARBITRARY_JOB_QUEUED;
+    job->refs = 2;
+    job->next = NULL;
+    arbitrary_search_control_init(&job->control);
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->shutting_down) {
+        // No worker would ever pick it up, so arbitrary_job_wait would hang
+        pthread_mutex_unlock(&pool->lock);
+        job_free(job);
+        return NULL;
+    }
+    if (pool->tail) {
+        pool->tail->next = job;
+    } else {
+        pool->head = job;
+    }
+    pool->tail = job;
+    pthread_cond_signal(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    return job;
+}
+
+ArbitraryJob* arbitrary_job_submit_subset_sum(ArbitraryJobPool* pool, const ArbitrarySubsetSumInstance* instance,
+                                              const char* checkpoint_path,
+                                              ArbitraryJobCallback callback, void* user_data) {
+    ArbitraryJob* job = malloc(sizeof(ArbitraryJob));
+    if (job) {
+        job->kind = JOB_SUBSET_SUM;
+        job->instance.subset_sum = *instance;
+    }
+    return job_submit(pool, job, checkpoint_path, callback, user_data);
+}
+
+ArbitraryJob* arbitrary_job_submit_qap(ArbitraryJobPool* pool, const ArbitraryQAPInstance* instance,
+                                       const char* checkpoint_path,
+                                       ArbitraryJobCallback callback, void* user_data) {
+    ArbitraryJob* job = malloc(sizeof(ArbitraryJob));
+    if (job) {
+        job->kind = JOB_QAP;
+        job->instance.qap = *instance;
+    }
+    return job_submit(pool, job, checkpoint_path, callback, user_data);
+}
+
+static ArbitraryNumber* job_number(ArbitraryRational value) {
+    ArbitraryNumber* num = arbitrary_create();
+    arbitrary_add_term(num, 1, value.num, value.den);
+    return num;
+}
+
+void arbitrary_job_progress(ArbitraryJob* job, ArbitraryJobProgress* progress) {
+    pthread_mutex_lock(&job->pool->lock);
+    progress->state = job->state;
+    pthread_mutex_unlock(&job->pool->lock);
+
+    progress->nodes_explored = atomic_load(&job->control.nodes_explored);
+    progress->nodes_total = atomic_load(&job->control.nodes_total);
+    progress->best = NULL;
+    progress->bound_gap = NULL;
+
+    pthread_mutex_lock(&job->control.lock);
+    if (job->control.has_best) {
+        progress->best = job_number(job->control.best);
+        progress->bound_gap = job_number(job->control.bound_gap);
+    }
+    pthread_mutex_unlock(&job->control.lock);
+}
+
+void arbitrary_job_cancel(ArbitraryJob* job) {
+    atomic_store(&job->control.cancel_requested, true);
+}
+
+const ArbitrarySolveResult* arbitrary_job_wait(ArbitraryJob* job) {
+    ArbitraryJobPool* pool = job->pool;
+    pthread_mutex_lock(&pool->lock);
+    while (job->state != ARBITRARY_JOB_FINISHED) {
+        pthread_cond_wait(&pool->job_finished, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return &job->result;
+}
+
+void arbitrary_job_release(ArbitraryJob* job) {
+    if (!job) return;
+    ArbitraryJobPool* pool = job->pool;
+    pthread_mutex_lock(&pool->lock);
+    bool last = job_unref_locked(job);
+    pthread_mutex_unlock(&pool->lock);
+    if (last) job_free(job);
+}
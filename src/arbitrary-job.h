@@ -0,0 +1,54 @@
+#ifndef ARBITRARY_JOB_H
+#define ARBITRARY_JOB_H
+
+#include "arbitrary-solve.h"
+
+// === In-process asynchronous solve jobs ===
+// Jobs run on a fixed pool of worker threads. A handle can be polled for
+// progress, cancelled cooperatively, or waited on; the completion callback
+// runs on the worker thread once the result is final.
+
+typedef struct ArbitraryJobPool ArbitraryJobPool;
+typedef struct ArbitraryJob ArbitraryJob;
+
+typedef enum {
+    ARBITRARY_JOB_QUEUED,
+    ARBITRARY_JOB_RUNNING,
+    ARBITRARY_JOB_FINISHED
+} ArbitraryJobState;
+
+typedef struct {
+    ArbitraryJobState state;
+    uint64_t nodes_explored;
+    uint64_t nodes_total;
+    ArbitraryNumber* best;       // Best so far, or NULL; free with arbitrary_free
+    ArbitraryNumber* bound_gap;  // Gap to the bound, or NULL; free with arbitrary_free
+} ArbitraryJobProgress;
+
+typedef void (*ArbitraryJobCallback)(ArbitraryJob* job, const ArbitrarySolveResult* result, void* user_data);
+
+ArbitraryJobPool* arbitrary_job_pool_create(int threads);
+// Cancels queued and running jobs, waits for the workers and frees the pool.
+void arbitrary_job_pool_free(ArbitraryJobPool* pool);
+
+// The instance is copied. checkpoint_path may be NULL; otherwise the job
+// resumes from and appends to that log (see arbitrary-checkpoint.h), writing
+// at most every ARBITRARY_JOB_CHECKPOINT_INTERVAL seconds. callback may be NULL. The returned handle must be
+// released with arbitrary_job_release before the pool is freed. Returns NULL
+// if the pool is shutting down or memory runs out.
+#define ARBITRARY_JOB_CHECKPOINT_INTERVAL 10.0
+
+ArbitraryJob* arbitrary_job_submit_subset_sum(ArbitraryJobPool* pool, const ArbitrarySubsetSumInstance* instance,
+                                              const char* checkpoint_path,
+                                              ArbitraryJobCallback callback, void* user_data);
+ArbitraryJob* arbitrary_job_submit_qap(ArbitraryJobPool* pool, const ArbitraryQAPInstance* instance,
+                                       const char* checkpoint_path,
+                                       ArbitraryJobCallback callback, void* user_data);
+
+void arbitrary_job_progress(ArbitraryJob* job, ArbitraryJobProgress* progress);
+void arbitrary_job_cancel(ArbitraryJob* job);
+// Blocks until the job has finished and its callback has returned.
+const ArbitrarySolveResult* arbitrary_job_wait(ArbitraryJob* job);
+void arbitrary_job_release(ArbitraryJob* job);
+
+#endif
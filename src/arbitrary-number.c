@@ -1,4 +1,4 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -35,7 +35,7 @@ void arbitrary_print(const ArbitraryNumber* num) {
     printf("ArbitraryNumber: ");
     for (size_t i = 0; i < num->length; ++i) {
         ArbitraryTerm t = num->terms[i];
-        printf("%s%lld*(%lld/%lld)", (i > 0 ? " + " : ""), t.c, t.a, t.b);
+        printf("%s%lld*(%lld/%lld)", (i > 0 ? " + " : ""), (long long)t.c, (long long)t.a, (long long)t.b);
     }
     printf("\n");
 }
@@ -77,9 +77,13 @@ ArbitraryNumber* arbitrary_multiply(const ArbitraryNumber* a, const ArbitraryNum
             ArbitraryTerm t1 = a->terms[i];
             ArbitraryTerm t2 = b->terms[j];
 
-            int64_t c = t1.c * t2.c;
-            int64_t num = t1.a * t2.a;
-            int64_t denom = t1.b * t2.b;
+            int64_t c, num, denom;
+            if (__builtin_mul_overflow(t1.c, t2.c, &c) ||
+                __builtin_mul_overflow(t1.a, t2.a, &num) ||
+                __builtin_mul_overflow(t1.b, t2.b, &denom)) {
+                arbitrary_free(result);
+                return NULL;
+            }
 
             arbitrary_add_term(result, c, num, denom);
         }
@@ -87,3 +91,133 @@ ArbitraryNumber* arbitrary_multiply(const ArbitraryNumber* a, const ArbitraryNum
 
     return result;
 }
+
+// === Binary form ===
+
+void arbitrary_put_u32(uint8_t* buf, uint32_t value) {
+    for (int i = 0; i < 4; i++) buf[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint32_t arbitrary_get_u32(const uint8_t* buf) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)buf[i] << (8 * i);
+    return value;
+}
+
+void arbitrary_put_u64(uint8_t* buf, uint64_t value) {
+    for (int i = 0; i < 8; i++) buf[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint64_t arbitrary_get_u64(const uint8_t* buf) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)buf[i] << (8 * i);
+    return value;
+}
+
+size_t arbitrary_serialized_size(const ArbitraryNumber* num) {
+    return 4 + num->length * 3 * 8;
+}
+
+size_t arbitrary_serialize(const ArbitraryNumber* num, uint8_t* buf, size_t capacity) {
+    size_t size = arbitrary_serialized_size(num);
+    if (size > capacity || num->length > UINT32_MAX) return 0;
+
+    arbitrary_put_u32(buf, (uint32_t)num->length);
+    uint8_t* p = buf + 4;
+    for (size_t i = 0; i < num->length; ++i) {
+        arbitrary_put_u64(p, (uint64_t)num->terms[i].c);
+        arbitrary_put_u64(p + 8, (uint64_t)num->terms[i].a);
+        arbitrary_put_u64(p + 16, (uint64_t)num->terms[i].b);
+        p += 24;
+    }
+    return size;
+}
+
+ArbitraryNumber* arbitrary_deserialize(const uint8_t* buf, size_t len, size_t* consumed) {
+    if (len < 4) return NULL;
+    size_t count = arbitrary_get_u32(buf);
+    if (count > (len - 4) / 24) return NULL;
+
+    ArbitraryNumber* num = arbitrary_create();
+    const uint8_t* p = buf + 4;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t b = (int64_t)arbitrary_get_u64(p + 16);
+        if (b == 0) {
+            arbitrary_free(num);
+            return NULL;
+        }
+        arbitrary_add_term(num, (int64_t)arbitrary_get_u64(p), (int64_t)arbitrary_get_u64(p + 8), b);
+        p += 24;
+    }
+    if (consumed) *consumed = 4 + count * 24;
+    return num;
+}
+
+// === Exact rational value ===
+// Intermediates use 128-bit integers: every product of two int64 values fits,
+// so only the final reduced result can overflow.
+
+static __int128 gcd128(__int128 a, __int128 b) {
+    if (a < 0) a = -a;
+    if (b < 0) b = -b;
+    while (b != 0) {
+        __int128 temp = b;
+        b = a % b;
+        a = temp;
+    }
+    return a;
+}
+
+static bool rational_reduce(__int128 num, __int128 den, ArbitraryRational* out) {
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    __int128 common = gcd128(num, den);
+    if (common > 1) {
+        num /= common;
+        den /= common;
+    }
+    if (num < INT64_MIN || num > INT64_MAX || den > INT64_MAX) return false;
+    out->num = (int64_t)num;
+    out->den = (int64_t)den;
+    return true;
+}
+
+bool arbitrary_evaluate(const ArbitraryNumber* num, ArbitraryRational* out) {
+    ArbitraryRational acc = {0, 1};
+    for (size_t i = 0; i < num->length; ++i) {
+        ArbitraryTerm t = num->terms[i];
+        ArbitraryRational term;
+        if (!rational_reduce((__int128)t.c * t.a, t.b, &term)) return false;
+        if (!arbitrary_rational_add(&acc, term)) return false;
+    }
+    *out = acc;
+    return true;
+}
+
+bool arbitrary_rational_add(ArbitraryRational* acc, ArbitraryRational x) {
+    __int128 num = (__int128)acc->num * x.den + (__int128)x.num * acc->den;
+    __int128 den = (__int128)acc->den * x.den;
+    return rational_reduce(num, den, acc);
+}
+
+bool arbitrary_rational_sub(ArbitraryRational* acc, ArbitraryRational x) {
+    __int128 num = (__int128)acc->num * x.den - (__int128)x.num * acc->den;
+    __int128 den = (__int128)acc->den * x.den;
+    return rational_reduce(num, den, acc);
+}
+
+bool arbitrary_rational_mul(ArbitraryRational* acc, ArbitraryRational x) {
+    __int128 num = (__int128)acc->num * x.num;
+    __int128 den = (__int128)acc->den * x.den;
+    return rational_reduce(num, den, acc);
+}
+
+int arbitrary_rational_compare(ArbitraryRational x, ArbitraryRational y) {
+    __int128 lhs = (__int128)x.num * y.den;
+    __int128 rhs = (__int128)y.num * x.den;
+    if (lhs < rhs) return -1;
+    if (lhs > rhs) return 1;
+    return 0;
+}
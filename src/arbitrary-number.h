@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 typedef struct {
     int64_t c;  // Coefficient (can be negative)
@@ -16,6 +17,12 @@ typedef struct {
     size_t capacity;
 } ArbitraryNumber;
 
+// Reduced rational value of an ArbitraryNumber (den > 0, gcd(num, den) == 1)
+typedef struct {
+    int64_t num;
+    int64_t den;
+} ArbitraryRational;
+
 // === Core API ===
 
 ArbitraryNumber* arbitrary_create();
@@ -24,6 +31,31 @@ void arbitrary_free(ArbitraryNumber* num);
 void arbitrary_add_term(ArbitraryNumber* num, int64_t c, int64_t a, int64_t b);
 void arbitrary_print(const ArbitraryNumber* num);
 ArbitraryNumber* arbitrary_add(const ArbitraryNumber* a, const ArbitraryNumber* b);
-ArbitraryNumber* arbitrary_multiply(const ArbitraryNumber* a, const ArbitraryNumber* b);
+ArbitraryNumber* arbitrary_multiply(const ArbitraryNumber* a, const ArbitraryNumber* b);  // NULL if a term product overflows int64
+
+// === Binary form ===
+// Little-endian u32 term count followed by (c, a, b) as int64 per term.
+
+size_t arbitrary_serialized_size(const ArbitraryNumber* num);
+size_t arbitrary_serialize(const ArbitraryNumber* num, uint8_t* buf, size_t capacity);  // 0 if it does not fit
+ArbitraryNumber* arbitrary_deserialize(const uint8_t* buf, size_t len, size_t* consumed);  // NULL if malformed
+
+// Little-endian field helpers shared by the binary formats
+void arbitrary_put_u32(uint8_t* buf, uint32_t value);
+uint32_t arbitrary_get_u32(const uint8_t* buf);
+void arbitrary_put_u64(uint8_t* buf, uint64_t value);
+uint64_t arbitrary_get_u64(const uint8_t* buf);
+
+// === Exact rational value ===
+// The rational_* operations return false if the reduced result does not fit
+// in 64-bit num/den. arbitrary_evaluate sums term by term and also returns
+// false when an intermediate partial sum does not fit, even if the final
+// value would (e.g. MAX + MAX + (-MAX)).
+
+bool arbitrary_evaluate(const ArbitraryNumber* num, ArbitraryRational* out);
+bool arbitrary_rational_add(ArbitraryRational* acc, ArbitraryRational x);
+bool arbitrary_rational_sub(ArbitraryRational* acc, ArbitraryRational x);
+bool arbitrary_rational_mul(ArbitraryRational* acc, ArbitraryRational x);
+int arbitrary_rational_compare(ArbitraryRational x, ArbitraryRational y);
 
 #endif
@@ -0,0 +1,329 @@
+#include "arbitrary-solve.h"
+#include <stdio.h>
+#include <string.h>
+
+void arbitrary_search_control_init(ArbitrarySearchControl* control) {
+    atomic_init(&control->cancel_requested, false);
+    atomic_init(&control->nodes_explored, 0);
+    atomic_init(&control->nodes_total, 0);
+    control->checkpoint = NULL;
+    pthread_mutex_init(&control->lock, NULL);
+    control->has_best = false;
+    control->best = (ArbitraryRational){0, 1};
+    control->bound_gap = (ArbitraryRational){0, 1};
+}
+
+void arbitrary_search_control_destroy(ArbitrarySearchControl* control) {
+    pthread_mutex_destroy(&control->lock);
+}
+
+bool arbitrary_subset_sum_instance_init(ArbitrarySubsetSumInstance* instance,
+                                        ArbitraryNumber* const* weights, int n,
+                                        const ArbitraryNumber* target) {
+    if (n < 1 || n > ARBITRARY_SUBSET_MAX) {
+        fprintf(stderr, "Error: subset-sum supports between 1 and %d weights.\n", ARBITRARY_SUBSET_MAX);
+        return false;
+    }
+    instance->n = n;
+    for (int i = 0; i < n; i++) {
+        if (!arbitrary_evaluate(weights[i], &instance->weights[i])) return false;
+    }
+    return arbitrary_evaluate(target, &instance->target);
+}
+
+bool arbitrary_qap_instance_init(ArbitraryQAPInstance* instance, int n,
+                                 ArbitraryNumber* const* A, ArbitraryNumber* const* B) {
+    if (n < 1 || n > ARBITRARY_PERM_MAX) {
+        fprintf(stderr, "Error: QAP supports between 1 and %d facilities.\n", ARBITRARY_PERM_MAX);
+        return false;
+    }
+    instance->n = n;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (!arbitrary_evaluate(A[i * n + j], &instance->A[i][j])) return false;
+            if (!arbitrary_evaluate(B[i * n + j], &instance->B[i][j])) return false;
+        }
+    }
+    return true;
+}
+
+// === Progress reporting ===
+
+static void solve_publish_best(ArbitrarySearchControl* control, const ArbitrarySolveResult* result) {
+    if (!control) return;
+    pthread_mutex_lock(&control->lock);
+    control->has_best = true;
+    control->best = result->best;
+    control->bound_gap = result->bound_gap;
+    pthread_mutex_unlock(&control->lock);
+}
+
+// Publishes the node count; returns true if the search should stop
+static bool solve_poll(ArbitrarySearchControl* control, uint64_t nodes) {
+    if (!control) return false;
+    atomic_store_explicit(&control->nodes_explored, nodes, memory_order_relaxed);
+    return atomic_load_explicit(&control->cancel_requested, memory_order_relaxed);
+}
+
+static void solve_finish(ArbitrarySearchControl* control, ArbitrarySolveResult* result,
+                         ArbitrarySolveStatus status, uint64_t nodes) {
+    result->status = status;
+    result->nodes_explored = nodes;
+    solve_poll(control, nodes);
+}
+
+// === Checkpoints ===
+
+static ArbitraryCheckpointLog* solve_log(ArbitrarySearchControl* control) {
+    return control ? control->checkpoint : NULL;
+}
+
+static uint64_t hash_rationals(uint64_t hash, const ArbitraryRational* values, int count) {
+    for (int i = 0; i < count; i++) {
+        hash = arbitrary_checkpoint_hash(hash, &values[i].num, sizeof(int64_t));
+        hash = arbitrary_checkpoint_hash(hash, &values[i].den, sizeof(int64_t));
+    }
+    return hash;
+}
+
+static void solve_checkpoint(ArbitrarySearchControl* control, ArbitraryCheckpointKind kind, uint64_t hash,
+                             uint64_t nodes, uint64_t rank, const ArbitraryPermIter* perm,
+                             const ArbitrarySolveResult* result) {
+    ArbitraryCheckpoint cp;
+    memset(&cp, 0, sizeof(cp));
+    cp.kind = kind;
+    cp.instance_hash = hash;
+    cp.nodes_explored = nodes;
+    cp.rank = rank;
+    if (perm) cp.perm = *perm;
+    cp.found = result->found;
+    cp.best = result->best;
+    cp.bound_gap = result->bound_gap;
+    cp.best_mask = result->best_mask;
+    memcpy(cp.best_perm, result->best_perm, sizeof(cp.best_perm));
+    arbitrary_checkpoint_write(control->checkpoint, &cp);
+}
+
+static void solve_restore(ArbitrarySearchControl* control, ArbitrarySolveResult* result,
+                          const ArbitraryCheckpoint* cp) {
+    result->nodes_resumed = cp->nodes_explored;
+    result->found = cp->found;
+    result->best = cp->best;
+    result->bound_gap = cp->bound_gap;
+    result->best_mask = cp->best_mask;
+    memcpy(result->best_perm, cp->best_perm, sizeof(result->best_perm));
+    if (cp->found) solve_publish_best(control, result);
+    solve_poll(control, cp->nodes_explored);
+}
+
+// === Subset-sum: closest subset to the target, Gray-code order ===
+
+ArbitrarySolveStatus arbitrary_solve_subset_sum(const ArbitrarySubsetSumInstance* instance,
+                                                ArbitrarySearchControl* control,
+                                                ArbitrarySolveResult* result) {
+    memset(result, 0, sizeof(*result));
+    if (control) atomic_store(&control->nodes_total, (UINT64_C(1) << instance->n) - 1);
+
+    ArbitraryCheckpointLog* log = solve_log(control);
+    uint64_t hash = arbitrary_checkpoint_hash(ARBITRARY_CHECKPOINT_HASH_SEED, &instance->n, sizeof(int));
+    hash = hash_rationals(hash, instance->weights, instance->n);
+    hash = hash_rationals(hash, &instance->target, 1);
+
+    ArbitrarySubsetIter it;
+    ArbitrarySubsetDelta delta;
+    ArbitraryRational sum = {0, 1};
+    ArbitraryCheckpoint cp;
+    uint64_t nodes = 0;
+    uint64_t begin = 0;
+
+    if (arbitrary_checkpoint_resume(log, ARBITRARY_CHECKPOINT_SUBSET_SUM, hash, &cp)) {
+        solve_restore(control, result, &cp);
+        nodes = cp.nodes_explored;
+        begin = cp.rank;
+    }
+
+    arbitrary_subset_iter_init(&it, instance->n, begin, UINT64_MAX);
+    for (int i = 0; i < instance->n; i++) {
+        if (((it.mask >> i) & 1) && !arbitrary_rational_add(&sum, instance->weights[i])) {
+            solve_finish(control, result, ARBITRARY_SOLVE_OVERFLOW, nodes);
+            return result->status;
+        }
+    }
+
+    while (!(result->found && result->bound_gap.num == 0) && arbitrary_subset_iter_next(&it, &delta)) {
+        bool ok = delta.added ? arbitrary_rational_add(&sum, instance->weights[delta.index])
+                              : arbitrary_rational_sub(&sum, instance->weights[delta.index]);
+        ArbitraryRational gap = sum;
+        ok = ok && arbitrary_rational_sub(&gap, instance->target) && gap.num != INT64_MIN;
+        if (!ok) {
+            solve_finish(control, result, ARBITRARY_SOLVE_OVERFLOW, nodes);
+            return result->status;
+        }
+        nodes++;
+
+        if (gap.num < 0) gap.num = -gap.num;
+        if (!result->found || arbitrary_rational_compare(gap, result->bound_gap) < 0) {
+            result->found = true;
+            result->best = sum;
+            result->bound_gap = gap;
+            result->best_mask = it.mask;
+            solve_publish_best(control, result);
+        }
+
+        if (nodes % ARBITRARY_SOLVE_POLL_INTERVAL == 0) {
+            bool cancelled = solve_poll(control, nodes);
+            if (log && (cancelled || arbitrary_checkpoint_due(log))) {
+                solve_checkpoint(control, ARBITRARY_CHECKPOINT_SUBSET_SUM, hash, nodes, it.rank, NULL, result);
+            }
+            if (cancelled) {
+                solve_finish(control, result, ARBITRARY_SOLVE_CANCELLED, nodes);
+                return result->status;
+            }
+        }
+    }
+
+    if (log) solve_checkpoint(control, ARBITRARY_CHECKPOINT_SUBSET_SUM, hash, nodes, it.rank, NULL, result);
+    solve_finish(control, result, ARBITRARY_SOLVE_DONE, nodes);
+    return result->status;
+}
+
+// === QAP: lowest-cost assignment, Heap's order with O(N) swap updates ===
+
+static bool qap_add_term(const ArbitraryQAPInstance* instance, const int* pi, int i, int j,
+                         ArbitraryRational* total) {
+    ArbitraryRational term = instance->A[i][j];
+    return arbitrary_rational_mul(&term, instance->B[pi[i]][pi[j]]) &&
+           arbitrary_rational_add(total, term);
+}
+
+static bool qap_cost(const ArbitraryQAPInstance* instance, const int* pi, ArbitraryRational* cost) {
+    *cost = (ArbitraryRational){0, 1};
+    for (int i = 0; i < instance->n; i++) {
+        for (int j = 0; j < instance->n; j++) {
+            if (!qap_add_term(instance, pi, i, j, cost)) return false;
+        }
+    }
+    return true;
+}
+
+// Terms in rows and columns u and v: the only ones a swap of u and v changes
+static bool qap_swap_terms(const ArbitraryQAPInstance* instance, const int* pi, int u, int v,
+                           ArbitraryRational* total) {
+    *total = (ArbitraryRational){0, 1};
+    for (int p = 0; p < instance->n; p++) {
+        if (!qap_add_term(instance, pi, u, p, total) || !qap_add_term(instance, pi, v, p, total)) return false;
+        if (p != u && p != v) {
+            if (!qap_add_term(instance, pi, p, u, total) || !qap_add_term(instance, pi, p, v, total)) return false;
+        }
+    }
+    return true;
+}
+
+// Each term A[i][j] * B[pi(i)][pi(j)] is at least the smallest product over
+// locations that are equal exactly when i == j, whatever the signs.
+static bool qap_lower_bound(const ArbitraryQAPInstance* instance, ArbitraryRational* bound) {
+    int n = instance->n;
+    *bound = (ArbitraryRational){0, 1};
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            ArbitraryRational smallest = {0, 1};
+            bool first = true;
+            for (int k = 0; k < n; k++) {
+                for (int l = 0; l < n; l++) {
+                    if ((k == l) != (i == j)) continue;
+                    ArbitraryRational term = instance->A[i][j];
+                    if (!arbitrary_rational_mul(&term, instance->B[k][l])) return false;
+                    if (first || arbitrary_rational_compare(term, smallest) < 0) smallest = term;
+                    first = false;
+                }
+            }
+            if (!arbitrary_rational_add(bound, smallest)) return false;
+        }
+    }
+    return true;
+}
+
+static bool qap_record(ArbitrarySearchControl* control, ArbitrarySolveResult* result,
+                       const ArbitraryPermIter* it, ArbitraryRational cost, ArbitraryRational bound) {
+    if (result->found && arbitrary_rational_compare(cost, result->best) >= 0) return true;
+
+    ArbitraryRational gap = cost;
+    if (!arbitrary_rational_sub(&gap, bound)) return false;
+    result->found = true;
+    result->best = cost;
+    result->bound_gap = gap;
+    memcpy(result->best_perm, it->perm, sizeof(int) * it->n);
+    solve_publish_best(control, result);
+    return true;
+}
+
+ArbitrarySolveStatus arbitrary_solve_qap(const ArbitraryQAPInstance* instance,
+                                         ArbitrarySearchControl* control,
+                                         ArbitrarySolveResult* result) {
+    memset(result, 0, sizeof(*result));
+    if (control) {
+        uint64_t total = 1;
+        for (int i = 2; i <= instance->n; i++) total *= i;
+        atomic_store(&control->nodes_total, total);
+    }
+
+    ArbitraryCheckpointLog* log = solve_log(control);
+    uint64_t hash = arbitrary_checkpoint_hash(ARBITRARY_CHECKPOINT_HASH_SEED, &instance->n, sizeof(int));
+    for (int i = 0; i < instance->n; i++) {
+        hash = hash_rationals(hash, instance->A[i], instance->n);
+        hash = hash_rationals(hash, instance->B[i], instance->n);
+    }
+
+    ArbitraryPermIter it;
+    ArbitraryPermDelta delta;
+    ArbitraryRational bound, cost, before, after;
+    ArbitraryCheckpoint cp;
+    uint64_t nodes = 1;
+
+    arbitrary_perm_iter_init(&it, instance->n);
+    if (arbitrary_checkpoint_resume(log, ARBITRARY_CHECKPOINT_QAP, hash, &cp) && cp.perm.n == instance->n) {
+        solve_restore(control, result, &cp);
+        nodes = cp.nodes_explored;
+        it = cp.perm;
+    }
+    if (!qap_lower_bound(instance, &bound) || !qap_cost(instance, it.perm, &cost) ||
+        !qap_record(control, result, &it, cost, bound)) {
+        solve_finish(control, result, ARBITRARY_SOLVE_OVERFLOW, 0);
+        return result->status;
+    }
+
+    while (result->bound_gap.num != 0 && arbitrary_perm_iter_next(&it, &delta)) {
+        // Swap back briefly to read the terms of the previous permutation
+        int* perm = it.perm;
+        int tmp = perm[delta.i];
+        perm[delta.i] = perm[delta.j];
+        perm[delta.j] = tmp;
+        bool ok = qap_swap_terms(instance, perm, delta.i, delta.j, &before);
+        perm[delta.j] = perm[delta.i];
+        perm[delta.i] = tmp;
+
+        ok = ok && qap_swap_terms(instance, perm, delta.i, delta.j, &after) &&
+             arbitrary_rational_sub(&cost, before) && arbitrary_rational_add(&cost, after) &&
+             qap_record(control, result, &it, cost, bound);
+        if (!ok) {
+            solve_finish(control, result, ARBITRARY_SOLVE_OVERFLOW, nodes);
+            return result->status;
+        }
+        nodes++;
+
+        if (nodes % ARBITRARY_SOLVE_POLL_INTERVAL == 0) {
+            bool cancelled = solve_poll(control, nodes);
+            if (log && (cancelled || arbitrary_checkpoint_due(log))) {
+                solve_checkpoint(control, ARBITRARY_CHECKPOINT_QAP, hash, nodes, 0, &it, result);
+            }
+            if (cancelled) {
+                solve_finish(control, result, ARBITRARY_SOLVE_CANCELLED, nodes);
+                return result->status;
+            }
+        }
+    }
+
+    if (log) solve_checkpoint(control, ARBITRARY_CHECKPOINT_QAP, hash, nodes, 0, &it, result);
+    solve_finish(control, result, ARBITRARY_SOLVE_DONE, nodes);
+    return result->status;
+}
@@ -0,0 +1,77 @@
+#ifndef ARBITRARY_SOLVE_H
+#define ARBITRARY_SOLVE_H
+
+#include <stdatomic.h>
+#include <pthread.h>
+#include "arbitrary-number.h"
+#include "arbitrary-enumerate.h"
+#include "arbitrary-checkpoint.h"
+
+// === Exhaustive exact solvers ===
+// Instances hold exact rational values, so they can be copied freely and
+// the caller's ArbitraryNumbers released once the instance is built.
+
+typedef struct {
+    int n;
+    ArbitraryRational weights[ARBITRARY_SUBSET_MAX];
+    ArbitraryRational target;
+} ArbitrarySubsetSumInstance;
+
+typedef struct {
+    int n;
+    ArbitraryRational A[ARBITRARY_PERM_MAX][ARBITRARY_PERM_MAX];  // Flow
+    ArbitraryRational B[ARBITRARY_PERM_MAX][ARBITRARY_PERM_MAX];  // Distance
+} ArbitraryQAPInstance;
+
+typedef enum {
+    ARBITRARY_SOLVE_DONE,
+    ARBITRARY_SOLVE_CANCELLED,
+    ARBITRARY_SOLVE_OVERFLOW  // An exact value no longer fit in 64 bits
+} ArbitrarySolveStatus;
+
+typedef struct {
+    ArbitrarySolveStatus status;
+    bool found;
+    ArbitraryRational best;       // Subset-sum: closest sum. QAP: lowest cost.
+    ArbitraryRational bound_gap;  // Subset-sum: |best - target|. QAP: best - lower bound.
+    uint64_t best_mask;
+    int best_perm[ARBITRARY_PERM_MAX];
+    uint64_t nodes_explored;
+    uint64_t nodes_resumed;       // Nodes already covered by the checkpoint resumed from
+} ArbitrarySolveResult;
+
+// Shared between a running solver and the threads observing it. The solver
+// publishes progress every ARBITRARY_SOLVE_POLL_INTERVAL nodes and checks for
+// cancellation and a due checkpoint at the same points.
+#define ARBITRARY_SOLVE_POLL_INTERVAL 4096
+
+typedef struct {
+    atomic_bool cancel_requested;
+    atomic_uint_fast64_t nodes_explored;
+    atomic_uint_fast64_t nodes_total;
+    ArbitraryCheckpointLog* checkpoint;  // Optional: resume from and append to this log
+    pthread_mutex_t lock;  // Guards the fields below
+    bool has_best;
+    ArbitraryRational best;
+    ArbitraryRational bound_gap;
+} ArbitrarySearchControl;
+
+void arbitrary_search_control_init(ArbitrarySearchControl* control);
+void arbitrary_search_control_destroy(ArbitrarySearchControl* control);
+
+// Return false if an input has no 64-bit rational value or n is out of range.
+bool arbitrary_subset_sum_instance_init(ArbitrarySubsetSumInstance* instance,
+                                        ArbitraryNumber* const* weights, int n,
+                                        const ArbitraryNumber* target);
+bool arbitrary_qap_instance_init(ArbitraryQAPInstance* instance, int n,
+                                 ArbitraryNumber* const* A, ArbitraryNumber* const* B);  // n*n, row-major
+
+// control may be NULL when nobody needs to observe or cancel the search.
+ArbitrarySolveStatus arbitrary_solve_subset_sum(const ArbitrarySubsetSumInstance* instance,
+                                                ArbitrarySearchControl* control,
+                                                ArbitrarySolveResult* result);
+ArbitrarySolveStatus arbitrary_solve_qap(const ArbitraryQAPInstance* instance,
+                                         ArbitrarySearchControl* control,
+                                         ArbitrarySolveResult* result);
+
+#endif
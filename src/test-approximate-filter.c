@@ -0,0 +1,154 @@
+#include "arbitrary-number.h"
+#include "arbitrary-filter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checks the approximate-first filter against exact brute force: every
+// subset within the tolerance must be reported, and nothing else. Subsets
+// whose exact sum overflows may only come back as undecided.
+
+#define MAX_N 16
+
+typedef struct {
+    unsigned char reported[1 << MAX_N];
+    unsigned char undecided[1 << MAX_N];
+} MatchSet;
+
+void record_match(uint64_t mask, const ArbitraryRational* sum, void* user_data) {
+    MatchSet* matches = (MatchSet*)user_data;
+    if (sum) {
+        matches->reported[mask]++;
+    } else {
+        matches->undecided[mask]++;
+    }
+}
+
+static uint64_t rng_state = 12345;
+
+static uint64_t next_random(void) {
+    uint64_t z = (rng_state += UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+static int64_t random_between(int64_t lo, int64_t hi) {
+    return lo + (int64_t)(next_random() % (uint64_t)(hi - lo + 1));
+}
+
+// Runs the filter and brute force on one instance; returns false on mismatch.
+// undecided, if not NULL, receives the number of subsets reported undecided.
+bool check_instance(const char* name, int n, const int64_t* num, const int64_t* den,
+                    int64_t target_num, int64_t target_den, int64_t tol_num, int64_t tol_den,
+                    uint64_t* undecided) {
+    ArbitraryNumber* weights[MAX_N];
+    ArbitraryRational values[MAX_N];
+    for (int i = 0; i < n; i++) {
+        weights[i] = arbitrary_create();
+        arbitrary_add_term(weights[i], 1, num[i], den[i]);
+        arbitrary_evaluate(weights[i], &values[i]);
+    }
+    ArbitraryNumber* target = arbitrary_create();
+    arbitrary_add_term(target, 1, target_num, target_den);
+    ArbitraryNumber* tolerance = arbitrary_create();
+    arbitrary_add_term(tolerance, 1, tol_num, tol_den);
+
+    ArbitraryRational target_value, tol_value;
+    arbitrary_evaluate(target, &target_value);
+    arbitrary_evaluate(tolerance, &tol_value);
+    ArbitraryRational lower = {-tol_value.num, tol_value.den};
+
+    static MatchSet matches;
+    memset(&matches, 0, sizeof(matches));
+    ArbitraryFilterStats stats;
+    ArbitraryMatchFilter* filter = arbitrary_filter_create(weights, n, target, tolerance);
+    if (!filter) {
+        printf("%s: filter creation failed\n", name);
+        return false;
+    }
+    arbitrary_filter_run(filter, record_match, &matches, &stats);
+    arbitrary_filter_free(filter);
+
+    // Brute force in the same index order, so overflow happens on the same subsets
+    bool ok = true;
+    uint64_t expected = 0, overflowed = 0;
+    for (uint64_t mask = 1; mask < (UINT64_C(1) << n); mask++) {
+        ArbitraryRational diff = {0, 1};
+        bool fits = true;
+        for (int i = 0; fits && i < n; i++) {
+            if ((mask >> i) & 1) fits = arbitrary_rational_add(&diff, values[i]);
+        }
+        fits = fits && arbitrary_rational_sub(&diff, target_value);
+        bool match = fits && arbitrary_rational_compare(diff, lower) >= 0 &&
+                     arbitrary_rational_compare(diff, tol_value) <= 0;
+        expected += match;
+        overflowed += matches.undecided[mask];
+        if (matches.reported[mask] != (match ? 1 : 0) || matches.undecided[mask] > (fits ? 0 : 1)) {
+            printf("%s: subset %llu %s\n", name, (unsigned long long)mask,
+                   match ? "was missed" : fits ? "was wrongly reported" : "overflowed but was reported");
+            ok = false;
+        }
+    }
+
+    if (stats.matches != expected || stats.overflows != overflowed) ok = false;
+    if (undecided) *undecided = overflowed;
+
+    for (int i = 0; i < n; i++) arbitrary_free(weights[i]);
+    arbitrary_free(target);
+    arbitrary_free(tolerance);
+    return ok;
+}
+
+int main() {
+    int failures = 0;
+    int64_t num[MAX_N], den[MAX_N];
+
+    // === Cancellation near the threshold ===
+    // 2^53 + 1 and -2^53 cancel to 1, which doubles cannot see exactly
+    int64_t big = INT64_C(1) << 53;
+    int64_t cancel_num[] = {big + 1, -big, 1, 1};
+    int64_t cancel_den[] = {1, 1, 3, 1};
+    failures += !check_instance("cancel exact", 4, cancel_num, cancel_den, 1, 1, 0, 1, NULL);
+    failures += !check_instance("cancel tiny tolerance", 4, cancel_num, cancel_den, 4, 3, 1, big, NULL);
+
+    // Sums that miss the target by exactly the tolerance, or by just over it
+    int64_t edge_num[] = {INT64_C(1) << 59, -(INT64_C(1) << 59) + 1, 1, 1};
+    int64_t edge_den[] = {1, 1, 1000003, 1000033};
+    failures += !check_instance("edge on tolerance", 4, edge_num, edge_den, 1, 1, 1, 1000003, NULL);
+    failures += !check_instance("edge just outside", 4, edge_num, edge_den, 1, 1, 1, 1000004, NULL);
+
+    // Every subset matches, but the two containing both large-prime
+    // denominators overflow exactly and must come back undecided
+    int64_t prime_num[] = {1, 1, 1};
+    int64_t prime_den[] = {4294967291, 4294967279, 1};
+    uint64_t undecided = 0;
+    failures += !check_instance("overflowing matches", 3, prime_num, prime_den, 1, 1, 1, 1, &undecided);
+    failures += undecided != 2;
+
+    // === Random instances, including magnitudes near 2^59 ===
+    for (int trial = 0; trial < 300; trial++) {
+        int n = (int)random_between(1, 12);
+        bool huge = trial % 3 == 0;
+        for (int i = 0; i < n; i++) {
+            int64_t scale = huge ? INT64_C(1) << 59 : 50;
+            num[i] = random_between(-scale, scale);
+            den[i] = huge ? 1 : random_between(1, 12);
+        }
+        // Aim the target at a real subset so matches exist
+        ArbitraryRational target = {0, 1};
+        for (int i = 0; i < n; i++) {
+            ArbitraryRational w = {num[i], den[i]};
+            if ((next_random() & 1) && !arbitrary_rational_add(&target, w)) break;
+        }
+        int64_t tol_num = random_between(0, 3);
+        int64_t tol_den = huge ? 1 : random_between(1, 24);
+
+        char name[32];
+        snprintf(name, sizeof(name), "random %d", trial);
+        failures += !check_instance(name, n, num, den, target.num, target.den, tol_num, tol_den, NULL);
+    }
+
+    printf("Approximate filter vs brute force: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
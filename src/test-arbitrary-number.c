@@ -1,4 +1,4 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdio.h>
 
 int main() {
@@ -11,6 +11,10 @@ int main() {
 
     ArbitraryNumber* sum = arbitrary_add(x, y);
     ArbitraryNumber* prod = arbitrary_multiply(x, y);
+    if (!prod) {
+        fprintf(stderr, "Error: product overflowed 64 bits.\n");
+        return 1;
+    }
 
     printf("x: "); arbitrary_print(x);
     printf("y: "); arbitrary_print(y);
@@ -0,0 +1,142 @@
+#include "arbitrary-number.h"
+#include "arbitrary-job.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define QAP_N 11  // 11! permutations: long enough to poll and cancel
+
+static const char* status_name(ArbitrarySolveStatus status) {
+    switch (status) {
+        case ARBITRARY_SOLVE_DONE: return "done";
+        case ARBITRARY_SOLVE_CANCELLED: return "cancelled";
+        default: return "overflow";
+    }
+}
+
+typedef struct {
+    const char* name;
+    atomic_int callbacks;  // Completion callback invocations
+} JobTag;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// Completion callback: runs on the worker thread
+void on_job_finished(ArbitraryJob* job, const ArbitrarySolveResult* result, void* user_data) {
+    JobTag* tag = user_data;
+    (void)job;
+    atomic_fetch_add(&tag->callbacks, 1);
+    printf("[%s] finished: %s after %llu nodes\n", tag->name,
+           status_name(result->status), (unsigned long long)result->nodes_explored);
+    if (result->found) {
+        ArbitraryNumber* best = arbitrary_create();
+        arbitrary_add_term(best, 1, result->best.num, result->best.den);
+        printf("[%s] best: ", tag->name);
+        arbitrary_print(best);
+        arbitrary_free(best);
+    }
+}
+
+// Prints progress and returns the node total the job reported
+uint64_t print_progress(const char* name, ArbitraryJob* job) {
+    ArbitraryJobProgress progress;
+    arbitrary_job_progress(job, &progress);
+    printf("[%s] progress: %llu / %llu nodes\n", name,
+           (unsigned long long)progress.nodes_explored, (unsigned long long)progress.nodes_total);
+    if (progress.best) {
+        printf("[%s] best so far: ", name);
+        arbitrary_print(progress.best);
+        printf("[%s] bound gap: ", name);
+        arbitrary_print(progress.bound_gap);
+    }
+    arbitrary_free(progress.best);
+    arbitrary_free(progress.bound_gap);
+    return progress.nodes_total;
+}
+
+// Waits until the job has published progress, however fast the machine is
+void wait_for_progress(ArbitraryJob* job) {
+    ArbitraryJobProgress progress;
+    do {
+        usleep(1000);
+        arbitrary_job_progress(job, &progress);
+        arbitrary_free(progress.best);
+        arbitrary_free(progress.bound_gap);
+    } while (progress.nodes_explored == 0 && progress.state != ARBITRARY_JOB_FINISHED);
+}
+
+int main() {
+    ArbitraryJobPool* pool = arbitrary_job_pool_create(2);
+    if (!pool) return 1;
+
+    // === Subset-sum job: weights {1/3, 1/2, 1/6, 1/4}, target 1 ===
+    int den[4] = {3, 2, 6, 4};
+    ArbitraryNumber* weights[4];
+    for (int i = 0; i < 4; i++) {
+        weights[i] = arbitrary_create();
+        arbitrary_add_term(weights[i], 1, 1, den[i]);
+    }
+    ArbitraryNumber* target = arbitrary_create();
+    arbitrary_add_term(target, 1, 1, 1);
+
+    ArbitrarySubsetSumInstance subset_sum;
+    if (!arbitrary_subset_sum_instance_init(&subset_sum, weights, 4, target)) return 1;
+    for (int i = 0; i < 4; i++) arbitrary_free(weights[i]);
+    arbitrary_free(target);
+
+    // === QAP job: A[i][j] = 1/(i+j+2), B[i][j] = 1/(|i-j|+1) ===
+    ArbitraryNumber* A[QAP_N * QAP_N];
+    ArbitraryNumber* B[QAP_N * QAP_N];
+    for (int i = 0; i < QAP_N; i++) {
+        for (int j = 0; j < QAP_N; j++) {
+            A[i * QAP_N + j] = arbitrary_create();
+            arbitrary_add_term(A[i * QAP_N + j], 1, 1, i + j + 2);
+            B[i * QAP_N + j] = arbitrary_create();
+            arbitrary_add_term(B[i * QAP_N + j], 1, 1, abs(i - j) + 1);
+        }
+    }
+
+    ArbitraryQAPInstance qap;
+    if (!arbitrary_qap_instance_init(&qap, QAP_N, A, B)) return 1;
+    for (int i = 0; i < QAP_N * QAP_N; i++) {
+        arbitrary_free(A[i]);
+        arbitrary_free(B[i]);
+    }
+
+    // === Submit both, poll the long one, then cancel it ===
+    JobTag subset_tag = {"subset-sum", 0};
+    JobTag qap_tag = {"qap", 0};
+    ArbitraryJob* subset_job = arbitrary_job_submit_subset_sum(pool, &subset_sum, NULL, on_job_finished, &subset_tag);
+    ArbitraryJob* qap_job = arbitrary_job_submit_qap(pool, &qap, NULL, on_job_finished, &qap_tag);
+    if (!subset_job || !qap_job) return 1;
+
+    const ArbitrarySolveResult* result = arbitrary_job_wait(subset_job);
+    expect(result->status == ARBITRARY_SOLVE_DONE, "subset-sum job finishes");
+    expect(result->found && result->bound_gap.num == 0, "subset-sum job finds an exact subset");
+
+    wait_for_progress(qap_job);
+    uint64_t nodes_total = print_progress("qap", qap_job);
+    printf("[qap] requesting cancellation\n");
+    arbitrary_job_cancel(qap_job);
+    result = arbitrary_job_wait(qap_job);
+    printf("[qap] wait returned with status: %s\n", status_name(result->status));
+    expect(result->status == ARBITRARY_SOLVE_CANCELLED, "qap job reports cancellation");
+    expect(result->nodes_explored < nodes_total, "qap job stops before exhausting the search");
+
+    arbitrary_job_release(subset_job);
+    arbitrary_job_release(qap_job);
+    arbitrary_job_pool_free(pool);
+
+    expect(atomic_load(&subset_tag.callbacks) == 1, "subset-sum callback runs exactly once");
+    expect(atomic_load(&qap_tag.callbacks) == 1, "qap callback runs exactly once");
+
+    printf("Async job test: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
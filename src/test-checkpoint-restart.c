@@ -0,0 +1,164 @@
+#include "arbitrary-number.h"
+#include "arbitrary-solve.h"
+#include "arbitrary-job.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QAP_N 8
+#define SUBSET_N 16
+#define QAP_LOG "qap-checkpoint.log"
+#define SUBSET_LOG "subset-checkpoint.log"
+#define JOB_LOG "job-checkpoint.log"
+#define SHARED_LOG "shared-checkpoint.log"
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+typedef ArbitrarySolveStatus (*SolveFunction)(const void* instance, ArbitrarySearchControl* control,
+                                              ArbitrarySolveResult* result);
+
+static ArbitrarySolveStatus solve_qap(const void* instance, ArbitrarySearchControl* control,
+                                      ArbitrarySolveResult* result) {
+    return arbitrary_solve_qap(instance, control, result);
+}
+
+static ArbitrarySolveStatus solve_subset_sum(const void* instance, ArbitrarySearchControl* control,
+                                             ArbitrarySolveResult* result) {
+    return arbitrary_solve_subset_sum(instance, control, result);
+}
+
+void print_result(const char* label, const ArbitrarySolveResult* result) {
+    ArbitraryNumber* best = arbitrary_create();
+    arbitrary_add_term(best, 1, result->best.num, result->best.den);
+    printf("%s: %llu nodes (%llu resumed), best ", label, (unsigned long long)result->nodes_explored,
+           (unsigned long long)result->nodes_resumed);
+    arbitrary_print(best);
+    arbitrary_free(best);
+}
+
+// Nodes recorded in the last valid checkpoint of a log, or 0 if it has none
+static uint64_t logged_nodes(const char* path) {
+    ArbitraryCheckpointLog* log = arbitrary_checkpoint_open(path, 0);
+    uint64_t nodes = (log && log->has_last) ? log->last.nodes_explored : 0;
+    arbitrary_checkpoint_close(log);
+    return nodes;
+}
+
+// Runs with a checkpoint log, optionally cancelled before it starts
+static void run_logged(SolveFunction solve, const void* instance, const char* path, bool interrupt,
+                       ArbitrarySolveResult* result) {
+    ArbitrarySearchControl control;
+    arbitrary_search_control_init(&control);
+    // Long interval: only the cancellation and completion records get written
+    control.checkpoint = arbitrary_checkpoint_open(path, 3600.0);
+    atomic_store(&control.cancel_requested, interrupt);
+    solve(instance, &control, result);
+    arbitrary_checkpoint_close(control.checkpoint);
+    arbitrary_search_control_destroy(&control);
+}
+
+// Interrupts a search at its first poll point, tears the log tail as a crash
+// would, resumes, and compares against an uninterrupted run
+static void check_resume(const char* name, SolveFunction solve, const void* instance, const char* path) {
+    ArbitrarySolveResult reference, partial, resumed;
+    solve(instance, NULL, &reference);
+    print_result("Uninterrupted", &reference);
+
+    remove(path);
+    run_logged(solve, instance, path, true, &partial);
+    print_result("Interrupted", &partial);
+    expect(partial.status == ARBITRARY_SOLVE_CANCELLED, name);
+    expect(partial.nodes_explored == ARBITRARY_SOLVE_POLL_INTERVAL, "interrupted at the first poll point");
+    expect(logged_nodes(path) == partial.nodes_explored, "cancellation left a checkpoint record");
+
+    FILE* log_file = fopen(path, "ab");
+    fwrite("ANCK\x40\x00", 1, 6, log_file);
+    fclose(log_file);
+
+    run_logged(solve, instance, path, false, &resumed);
+    print_result("Resumed", &resumed);
+    expect(resumed.status == ARBITRARY_SOLVE_DONE, "resumed search completes");
+    expect(resumed.nodes_resumed == partial.nodes_explored, "resumed run starts from the checkpoint");
+    expect(resumed.nodes_explored == reference.nodes_explored, "resumed node count matches");
+    expect(arbitrary_rational_compare(resumed.best, reference.best) == 0, "resumed best value matches");
+    expect(resumed.best_mask == reference.best_mask &&
+           memcmp(resumed.best_perm, reference.best_perm, sizeof(resumed.best_perm)) == 0,
+           "resumed best solution matches");
+
+    remove(path);
+}
+
+int main() {
+    // === QAP instance: A[i][j] = 1/(i+j+2), B[i][j] = 1/(|i-j|+1) ===
+    ArbitraryNumber* A[QAP_N * QAP_N];
+    ArbitraryNumber* B[QAP_N * QAP_N];
+    for (int i = 0; i < QAP_N; i++) {
+        for (int j = 0; j < QAP_N; j++) {
+            A[i * QAP_N + j] = arbitrary_create();
+            arbitrary_add_term(A[i * QAP_N + j], 1, 1, i + j + 2);
+            B[i * QAP_N + j] = arbitrary_create();
+            arbitrary_add_term(B[i * QAP_N + j], 1, 1, abs(i - j) + 1);
+        }
+    }
+    ArbitraryQAPInstance qap;
+    if (!arbitrary_qap_instance_init(&qap, QAP_N, A, B)) return 1;
+    for (int i = 0; i < QAP_N * QAP_N; i++) {
+        arbitrary_free(A[i]);
+        arbitrary_free(B[i]);
+    }
+
+    // === Subset-sum instance: weights (3i + 1)/2, target 1/7 is never hit ===
+    ArbitraryNumber* weights[SUBSET_N];
+    for (int i = 0; i < SUBSET_N; i++) {
+        weights[i] = arbitrary_create();
+        arbitrary_add_term(weights[i], 1, 3 * i + 1, 2);
+    }
+    ArbitraryNumber* target = arbitrary_create();
+    arbitrary_add_term(target, 1, 1, 7);
+    ArbitrarySubsetSumInstance subset_sum;
+    if (!arbitrary_subset_sum_instance_init(&subset_sum, weights, SUBSET_N, target)) return 1;
+    for (int i = 0; i < SUBSET_N; i++) arbitrary_free(weights[i]);
+    arbitrary_free(target);
+
+    printf("=== QAP ===\n");
+    check_resume("qap search is interrupted", solve_qap, &qap, QAP_LOG);
+    printf("=== Subset-sum ===\n");
+    check_resume("subset-sum search is interrupted", solve_subset_sum, &subset_sum, SUBSET_LOG);
+
+    // === Two instances interrupted into one log each resume their own record ===
+    printf("=== Shared log ===\n");
+    ArbitrarySolveResult partial, resumed;
+    remove(SHARED_LOG);
+    run_logged(solve_subset_sum, &subset_sum, SHARED_LOG, true, &partial);
+    run_logged(solve_qap, &qap, SHARED_LOG, true, &partial);
+    run_logged(solve_subset_sum, &subset_sum, SHARED_LOG, false, &resumed);
+    print_result("Subset-sum after QAP", &resumed);
+    expect(resumed.nodes_resumed == ARBITRARY_SOLVE_POLL_INTERVAL, "subset-sum resumes past the QAP record");
+    run_logged(solve_qap, &qap, SHARED_LOG, false, &resumed);
+    print_result("QAP after subset-sum", &resumed);
+    expect(resumed.nodes_resumed == ARBITRARY_SOLVE_POLL_INTERVAL, "QAP resumes past the subset-sum record");
+    remove(SHARED_LOG);
+
+    // === Jobs submitted with a checkpoint path write their final record ===
+    remove(JOB_LOG);
+    ArbitraryJobPool* pool = arbitrary_job_pool_create(1);
+    if (!pool) return 1;
+    ArbitraryJob* job = arbitrary_job_submit_subset_sum(pool, &subset_sum, JOB_LOG, NULL, NULL);
+    if (!job) return 1;
+    const ArbitrarySolveResult* result = arbitrary_job_wait(job);
+    expect(result->status == ARBITRARY_SOLVE_DONE, "checkpointed job completes");
+    expect(logged_nodes(JOB_LOG) == result->nodes_explored, "job wrote its final checkpoint");
+    arbitrary_job_release(job);
+    arbitrary_job_pool_free(pool);
+    remove(JOB_LOG);
+
+    printf("Checkpoint/restart test: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,620 @@
+#include "arbitrary-number.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Differential test: every ArbitraryNumber operation is checked against a
+// straightforward reference rational. With -DHAVE_GMP the reference is GMP's
+// mpq_t; otherwise a small built-in bignum rational is used.
+//
+// Random driver:  ./test-differential-arbitrary-number [iterations] [seed] [corpus files...]
+// libFuzzer:      build with -DARBITRARY_FUZZ -fsanitize=fuzzer (make fuzz)
+// Corpus files given to the random driver are replayed through the same
+// path as fuzzer inputs, so the seed corpus also runs under make test.
+
+#define MAX_TERMS 6  // Products of two numbers stay within the reference size
+
+// === Reference rational ===
+
+#ifdef HAVE_GMP
+#include <gmp.h>
+
+typedef mpq_t RefRational;
+
+static void ref_init(RefRational r) { mpq_init(r); }
+static void ref_clear(RefRational r) { mpq_clear(r); }
+
+static void ref_set_term(RefRational r, int64_t c, int64_t a, int64_t b) {
+    mpz_t num, den;
+    mpz_init(num);
+    mpz_init(den);
+    mpz_import(num, 1, 1, sizeof(uint64_t), 0, 0, &(uint64_t){c < 0 ? -(uint64_t)c : (uint64_t)c});
+    if (c < 0) mpz_neg(num, num);
+    mpz_t factor;
+    mpz_init(factor);
+    mpz_import(factor, 1, 1, sizeof(uint64_t), 0, 0, &(uint64_t){a < 0 ? -(uint64_t)a : (uint64_t)a});
+    if (a < 0) mpz_neg(factor, factor);
+    mpz_mul(num, num, factor);
+    mpz_import(den, 1, 1, sizeof(uint64_t), 0, 0, &(uint64_t){b < 0 ? -(uint64_t)b : (uint64_t)b});
+    if (b < 0) mpz_neg(den, den);
+    mpq_set_num(r, num);
+    mpq_set_den(r, den);
+    mpq_canonicalize(r);
+    mpz_clear(factor);
+    mpz_clear(num);
+    mpz_clear(den);
+}
+
+static void ref_add(RefRational r, RefRational x, RefRational y) { mpq_add(r, x, y); }
+static void ref_sub(RefRational r, RefRational x, RefRational y) { mpq_sub(r, x, y); }
+static void ref_mul(RefRational r, RefRational x, RefRational y) { mpq_mul(r, x, y); }
+static int ref_cmp(RefRational x, RefRational y) { int c = mpq_cmp(x, y); return (c > 0) - (c < 0); }
+
+// mpq_t is kept canonical, so this is the reduced value (long is 64-bit here)
+static bool ref_fits_int64(RefRational r) {
+    mpq_canonicalize(r);
+    return mpz_fits_slong_p(mpq_numref(r)) && mpz_fits_slong_p(mpq_denref(r));
+}
+
+#else
+
+#define BIG_LIMBS 192  // 6144 bits
+
+typedef struct {
+    int sign;  // -1, 0 or 1
+    int len;
+    uint32_t limb[BIG_LIMBS];
+} Big;
+
+typedef struct {
+    Big num;
+    Big den;  // Always positive, not reduced
+} RefRational[1];
+
+static void big_from_i64(Big* x, int64_t value) {
+    uint64_t mag = value < 0 ? -(uint64_t)value : (uint64_t)value;
+    x->sign = (value > 0) - (value < 0);
+    x->limb[0] = (uint32_t)mag;
+    x->limb[1] = (uint32_t)(mag >> 32);
+    x->len = mag == 0 ? 0 : (mag >> 32 ? 2 : 1);
+}
+
+static int big_cmp_mag(const Big* x, const Big* y) {
+    if (x->len != y->len) return x->len < y->len ? -1 : 1;
+    for (int i = x->len - 1; i >= 0; i--) {
+        if (x->limb[i] != y->limb[i]) return x->limb[i] < y->limb[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static void big_trim(Big* x) {
+    while (x->len > 0 && x->limb[x->len - 1] == 0) x->len--;
+    if (x->len == 0) x->sign = 0;
+}
+
+// |r| = |x| + |y|
+static void big_add_mag(Big* r, const Big* x, const Big* y) {
+    int len = x->len > y->len ? x->len : y->len;
+    uint64_t carry = 0;
+    for (int i = 0; i < len; i++) {
+        uint64_t sum = carry + (i < x->len ? x->limb[i] : 0) + (i < y->len ? y->limb[i] : 0);
+        r->limb[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    if (carry) {
+        if (len == BIG_LIMBS) abort();
+        r->limb[len++] = (uint32_t)carry;
+    }
+    r->len = len;
+}
+
+// |r| = |x| - |y|, requires |x| >= |y|
+static void big_sub_mag(Big* r, const Big* x, const Big* y) {
+    int64_t borrow = 0;
+    for (int i = 0; i < x->len; i++) {
+        int64_t diff = (int64_t)x->limb[i] - (i < y->len ? y->limb[i] : 0) - borrow;
+        borrow = diff < 0;
+        r->limb[i] = (uint32_t)(diff + (borrow ? (INT64_C(1) << 32) : 0));
+    }
+    r->len = x->len;
+}
+
+static void big_add(Big* r, const Big* x, const Big* y) {
+    Big result;
+    if (x->sign == 0) {
+        result = *y;
+    } else if (y->sign == 0) {
+        result = *x;
+    } else if (x->sign == y->sign) {
+        big_add_mag(&result, x, y);
+        result.sign = x->sign;
+    } else if (big_cmp_mag(x, y) >= 0) {
+        big_sub_mag(&result, x, y);
+        result.sign = x->sign;
+    } else {
+        big_sub_mag(&result, y, x);
+        result.sign = y->sign;
+    }
+    big_trim(&result);
+    *r = result;
+}
+
+static void big_mul(Big* r, const Big* x, const Big* y) {
+    Big result;
+    if (x->len + y->len > BIG_LIMBS) abort();
+    memset(result.limb, 0, sizeof(uint32_t) * (x->len + y->len));
+    for (int i = 0; i < x->len; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < y->len; j++) {
+            uint64_t cur = (uint64_t)x->limb[i] * y->limb[j] + result.limb[i + j] + carry;
+            result.limb[i + j] = (uint32_t)cur;
+            carry = cur >> 32;
+        }
+        result.limb[i + y->len] = (uint32_t)carry;
+    }
+    result.len = x->len + y->len;
+    result.sign = x->sign * y->sign;
+    big_trim(&result);
+    *r = result;
+}
+
+static int big_cmp(const Big* x, const Big* y) {
+    if (x->sign != y->sign) return x->sign < y->sign ? -1 : 1;
+    return x->sign * big_cmp_mag(x, y);
+}
+
+static void ref_init(RefRational r) {
+    big_from_i64(&r->num, 0);
+    big_from_i64(&r->den, 1);
+}
+
+static void ref_clear(RefRational r) { (void)r; }
+
+static void ref_set_term(RefRational r, int64_t c, int64_t a, int64_t b) {
+    Big factor;
+    big_from_i64(&r->num, c);
+    big_from_i64(&factor, a);
+    big_mul(&r->num, &r->num, &factor);
+    big_from_i64(&r->den, b);
+    if (r->den.sign < 0) {
+        r->den.sign = 1;
+        r->num.sign = -r->num.sign;
+    }
+}
+
+static void ref_add(RefRational r, RefRational x, RefRational y) {
+    Big lhs, rhs;
+    big_mul(&lhs, &x->num, &y->den);
+    big_mul(&rhs, &y->num, &x->den);
+    big_add(&r->num, &lhs, &rhs);
+    big_mul(&r->den, &x->den, &y->den);
+}
+
+static void ref_sub(RefRational r, RefRational x, RefRational y) {
+    Big lhs, rhs;
+    big_mul(&lhs, &x->num, &y->den);
+    big_mul(&rhs, &y->num, &x->den);
+    rhs.sign = -rhs.sign;
+    big_add(&r->num, &lhs, &rhs);
+    big_mul(&r->den, &x->den, &y->den);
+}
+
+static void ref_mul(RefRational r, RefRational x, RefRational y) {
+    big_mul(&r->num, &x->num, &y->num);
+    big_mul(&r->den, &x->den, &y->den);
+}
+
+static int ref_cmp(RefRational x, RefRational y) {
+    Big lhs, rhs;
+    big_mul(&lhs, &x->num, &y->den);
+    big_mul(&rhs, &y->num, &x->den);
+    return big_cmp(&lhs, &rhs);
+}
+
+static int big_trailing_zeros(const Big* x) {
+    int limb = 0;
+    while (x->limb[limb] == 0) limb++;
+    return limb * 32 + __builtin_ctz(x->limb[limb]);
+}
+
+static void big_shift_right(Big* x, int bits) {
+    int limbs = bits / 32;
+    int rest = bits % 32;
+    for (int i = 0; i + limbs < x->len; i++) {
+        uint64_t wide = x->limb[i + limbs];
+        if (i + limbs + 1 < x->len) wide |= (uint64_t)x->limb[i + limbs + 1] << 32;
+        x->limb[i] = (uint32_t)(wide >> rest);
+    }
+    x->len = x->len > limbs ? x->len - limbs : 0;
+    big_trim(x);
+}
+
+static void big_shift_left(Big* x, int bits) {
+    int limbs = bits / 32;
+    int rest = bits % 32;
+    if (x->len + limbs + 1 > BIG_LIMBS) abort();
+    x->limb[x->len + limbs] = 0;
+    for (int i = x->len - 1; i >= 0; i--) {
+        uint64_t wide = (uint64_t)x->limb[i] << rest;
+        x->limb[i + limbs + 1] |= (uint32_t)(wide >> 32);
+        x->limb[i + limbs] = (uint32_t)wide;
+    }
+    for (int i = 0; i < limbs; i++) x->limb[i] = 0;
+    x->len += limbs + 1;
+    big_trim(x);
+}
+
+// Binary gcd of the magnitudes of two non-zero values
+static void big_gcd(Big* g, const Big* x, const Big* y) {
+    Big u = *x, v = *y;
+    u.sign = v.sign = 1;
+    int tu = big_trailing_zeros(&u), tv = big_trailing_zeros(&v);
+    int shift = tu < tv ? tu : tv;
+    big_shift_right(&u, tu);
+    for (;;) {
+        big_shift_right(&v, big_trailing_zeros(&v));
+        if (big_cmp_mag(&u, &v) > 0) {
+            Big t = u;
+            u = v;
+            v = t;
+        }
+        big_sub_mag(&v, &v, &u);
+        big_trim(&v);
+        if (v.sign == 0) break;
+    }
+    big_shift_left(&u, shift);
+    *g = u;
+}
+
+// Whether the reduced value fits in int64 num/den. Checked as
+// |num| <= L * g and den <= (2^63 - 1) * g to avoid dividing by g, where
+// L is 2^63 for a negative numerator and 2^63 - 1 otherwise.
+static bool ref_fits_int64(RefRational r) {
+    if (r->num.sign == 0) return true;
+    Big g, limit, bound;
+    big_gcd(&g, &r->num, &r->den);
+
+    big_from_i64(&limit, INT64_MAX);
+    big_mul(&bound, &limit, &g);
+    if (big_cmp_mag(&r->den, &bound) > 0) return false;
+
+    if (r->num.sign < 0) {
+        limit.len = 2;
+        limit.limb[0] = 0;
+        limit.limb[1] = UINT32_C(0x80000000);
+        big_mul(&bound, &limit, &g);
+    }
+    return big_cmp_mag(&r->num, &bound) <= 0;
+}
+
+#endif
+
+static void ref_from_number(RefRational r, const ArbitraryNumber* num) {
+    RefRational term;
+    ref_init(term);
+    ref_set_term(r, 0, 0, 1);
+    for (size_t i = 0; i < num->length; i++) {
+        ref_set_term(term, num->terms[i].c, num->terms[i].a, num->terms[i].b);
+        ref_add(r, r, term);
+    }
+    ref_clear(term);
+}
+
+static void ref_from_rational(RefRational r, ArbitraryRational x) {
+    ref_set_term(r, 1, x.num, x.den);
+}
+
+// === Checks ===
+
+static uint64_t checks;
+static uint64_t failures;
+static uint64_t overflows;  // Results reported as not fitting in 64 bits
+
+static void check(bool ok, const char* what) {
+    checks++;
+    if (!ok) {
+        failures++;
+        fprintf(stderr, "FAIL: %s\n", what);
+#ifdef ARBITRARY_FUZZ
+        abort();
+#endif
+    }
+}
+
+static int64_t gcd_u(int64_t a, int64_t b) {
+    uint64_t x = a < 0 ? -(uint64_t)a : (uint64_t)a;
+    uint64_t y = b < 0 ? -(uint64_t)b : (uint64_t)b;
+    while (y != 0) {
+        uint64_t t = y;
+        y = x % y;
+        x = t;
+    }
+    return (int64_t)x;
+}
+
+static bool fits_int64(__int128 x) {
+    return x >= INT64_MIN && x <= INT64_MAX;
+}
+
+static bool rational_canonical(ArbitraryRational x) {
+    return x.den > 0 && gcd_u(x.num, x.den) == 1;
+}
+
+// A successful rational result must be canonical and equal the reference;
+// a reported overflow must mean the reduced reference really does not fit
+static void check_rational(bool ok, ArbitraryRational got, RefRational expected, const char* what) {
+    if (!ok) {
+        overflows++;
+        check(!ref_fits_int64(expected), what);
+        return;
+    }
+    RefRational value;
+    ref_init(value);
+    ref_from_rational(value, got);
+    check(rational_canonical(got) && ref_cmp(value, expected) == 0, what);
+    ref_clear(value);
+}
+
+// arbitrary_evaluate reduces each term and adds it to a running sum, so it
+// must fail exactly when some reduced term or partial sum does not fit
+static void check_evaluate(const ArbitraryNumber* x, bool ok, ArbitraryRational got, RefRational expected) {
+    RefRational prefix, term;
+    bool fits = true;
+    ref_init(prefix);
+    ref_init(term);
+    for (size_t i = 0; fits && i < x->length; i++) {
+        ref_set_term(term, x->terms[i].c, x->terms[i].a, x->terms[i].b);
+        ref_add(prefix, prefix, term);
+        fits = ref_fits_int64(term) && ref_fits_int64(prefix);
+    }
+    ref_clear(prefix);
+    ref_clear(term);
+
+    check(ok == fits, "arbitrary_evaluate overflow");
+    if (ok) check_rational(ok, got, expected, "arbitrary_evaluate");
+    else overflows++;
+}
+
+// Whatever arbitrary_deserialize accepts must be exactly what it should
+// accept, and must serialize back to the same bytes
+static void check_deserialize(const uint8_t* data, size_t size) {
+    bool valid = size >= 4;
+    size_t count = valid ? arbitrary_get_u32(data) : 0;
+    valid = valid && count <= (size - 4) / 24;
+    for (size_t i = 0; valid && i < count; i++) {
+        valid = arbitrary_get_u64(data + 4 + i * 24 + 16) != 0;
+    }
+
+    size_t consumed = 0;
+    ArbitraryNumber* num = arbitrary_deserialize(data, size, &consumed);
+    check((num != NULL) == valid, "arbitrary_deserialize accepts exactly the valid inputs");
+    if (!num) return;
+
+    uint8_t* buf = malloc(consumed);
+    size_t written = buf ? arbitrary_serialize(num, buf, consumed) : 0;
+    check(consumed == 4 + count * 24 && written == consumed && memcmp(buf, data, consumed) == 0,
+          "arbitrary_deserialize round trip");
+    free(buf);
+    arbitrary_free(num);
+}
+
+static void check_pair(const ArbitraryNumber* x, const ArbitraryNumber* y) {
+    RefRational rx, ry, expected, got;
+    ref_init(rx);
+    ref_init(ry);
+    ref_init(expected);
+    ref_init(got);
+    ref_from_number(rx, x);
+    ref_from_number(ry, y);
+
+    // arbitrary_add / arbitrary_multiply keep terms symbolic
+    ArbitraryNumber* sum = arbitrary_add(x, y);
+    ref_add(expected, rx, ry);
+    ref_from_number(got, sum);
+    check(sum->length == x->length + y->length && ref_cmp(got, expected) == 0, "arbitrary_add");
+    arbitrary_free(sum);
+
+    // arbitrary_multiply forms c1*c2, a1*a2 and b1*b2 per term pair in int64
+    // and must return NULL exactly when one of those products does not fit
+    bool fits = true;
+    for (size_t i = 0; i < x->length; i++) {
+        for (size_t j = 0; j < y->length; j++) {
+            const ArbitraryTerm* tx = &x->terms[i];
+            const ArbitraryTerm* ty = &y->terms[j];
+            fits = fits && fits_int64((__int128)tx->c * ty->c) && fits_int64((__int128)tx->a * ty->a) &&
+                   fits_int64((__int128)tx->b * ty->b);
+        }
+    }
+    ArbitraryNumber* prod = arbitrary_multiply(x, y);
+    check((prod != NULL) == fits, "arbitrary_multiply reports overflow exactly when a product does not fit");
+    if (prod) {
+        ref_mul(expected, rx, ry);
+        ref_from_number(got, prod);
+        check(prod->length == x->length * y->length && ref_cmp(got, expected) == 0, "arbitrary_multiply");
+        arbitrary_free(prod);
+    } else {
+        overflows++;
+    }
+
+    // Exact evaluation and rational arithmetic
+    ArbitraryRational vx, vy;
+    bool ok_x = arbitrary_evaluate(x, &vx);
+    bool ok_y = arbitrary_evaluate(y, &vy);
+    check_evaluate(x, ok_x, vx, rx);
+    check_evaluate(y, ok_y, vy, ry);
+
+    if (ok_x && ok_y) {
+        RefRational qx, qy;
+        ref_init(qx);
+        ref_init(qy);
+        ref_from_rational(qx, vx);
+        ref_from_rational(qy, vy);
+
+        ArbitraryRational r = vx;
+        bool ok = arbitrary_rational_add(&r, vy);
+        ref_add(expected, qx, qy);
+        check_rational(ok, r, expected, "arbitrary_rational_add");
+
+        r = vx;
+        ok = arbitrary_rational_sub(&r, vy);
+        ref_sub(expected, qx, qy);
+        check_rational(ok, r, expected, "arbitrary_rational_sub");
+
+        r = vx;
+        ok = arbitrary_rational_mul(&r, vy);
+        ref_mul(expected, qx, qy);
+        check_rational(ok, r, expected, "arbitrary_rational_mul");
+
+        check(arbitrary_rational_compare(vx, vy) == ref_cmp(qx, qy), "arbitrary_rational_compare");
+
+        ref_clear(qx);
+        ref_clear(qy);
+    }
+
+    // Binary form round trip
+    uint8_t buf[4 + MAX_TERMS * 24];
+    size_t size = arbitrary_serialize(x, buf, sizeof(buf));
+    size_t consumed = 0;
+    ArbitraryNumber* back = arbitrary_deserialize(buf, size, &consumed);
+    check(size == arbitrary_serialized_size(x) && back && consumed == size &&
+          back->length == x->length &&
+          memcmp(back->terms, x->terms, sizeof(ArbitraryTerm) * x->length) == 0,
+          "arbitrary_serialize round trip");
+    arbitrary_free(back);
+
+    ref_clear(rx);
+    ref_clear(ry);
+    ref_clear(expected);
+    ref_clear(got);
+}
+
+// === Input generation ===
+// Values are drawn to favour the cases optimized paths get wrong: extremes,
+// values near powers of two, shared factors and sign mixes.
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    uint64_t state;  // splitmix64 when data runs out or for the random driver
+} Source;
+
+static uint64_t source_next(Source* src) {
+    if (src->size >= 8) {
+        uint64_t value;
+        memcpy(&value, src->data, 8);
+        src->data += 8;
+        src->size -= 8;
+        return value;
+    }
+    uint64_t z = (src->state += UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+static int64_t source_value(Source* src, bool small) {
+    uint64_t r = source_next(src);
+    int64_t value;
+    switch (r & 7) {
+        case 0: value = (int64_t)(r >> 8) % 16; break;                      // Tiny, shares factors often
+        case 1: value = INT64_C(1) << ((r >> 8) % 62); break;               // Powers of two
+        case 2: value = (INT64_C(1) << ((r >> 8) % 62)) - 1; break;
+        case 3: value = (r >> 16) & 1 ? INT64_MAX : INT64_MIN + 1; break;    // Extremes
+        default: value = (int64_t)(r >> 3); break;
+    }
+    if ((r >> 7) & 1) value = -value;
+    if (small) value %= INT64_C(1) << 31;
+    return value;
+}
+
+static ArbitraryNumber* source_number(Source* src, bool small) {
+    ArbitraryNumber* num = arbitrary_create();
+    int length = 1 + source_next(src) % MAX_TERMS;
+    for (int i = 0; i < length; i++) {
+        int64_t c = source_value(src, small);
+        int64_t a = source_value(src, small);
+        int64_t b = source_value(src, small);
+        arbitrary_add_term(num, c, a, b == 0 ? 1 : b);
+    }
+    return num;
+}
+
+// Serialized form of x with a few bytes damaged and a random truncation
+static void check_damaged_serialization(Source* src, const ArbitraryNumber* x) {
+    uint8_t buf[4 + MAX_TERMS * 24];
+    size_t size = arbitrary_serialize(x, buf, sizeof(buf));
+    uint64_t r = source_next(src);
+    for (int i = 0; i < (int)(r & 3); i++) {
+        buf[(r >> (8 + 8 * i)) % size] ^= (uint8_t)(r >> 40);
+    }
+    if ((r >> 4) & 1) size = (r >> 48) % (size + 1);
+    check_deserialize(buf, size);
+}
+
+static void run_case(Source* src) {
+    bool small = source_next(src) % 4 != 0;  // Mostly cases that stay in range
+    ArbitraryNumber* x = source_number(src, small);
+    ArbitraryNumber* y = source_number(src, small);
+    check_pair(x, y);
+    check_damaged_serialization(src, x);
+    arbitrary_free(x);
+    arbitrary_free(y);
+}
+
+// One fuzzer input: the raw bytes go straight to the only parser of
+// untrusted input, then drive the generator
+static void run_input(const uint8_t* data, size_t size) {
+    check_deserialize(data, size);
+
+    Source src = {data, size, size};
+    run_case(&src);
+}
+
+#ifdef ARBITRARY_FUZZ
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    run_input(data, size);
+    return 0;
+}
+
+#else
+
+// Replays a corpus file through the fuzzer entry path
+static bool replay_file(const char* path) {
+    uint8_t data[4096];
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Error: cannot read corpus file %s.\n", path);
+        return false;
+    }
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    run_input(data, size);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 100000;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 0) : 1;
+
+    for (int i = 3; i < argc; i++) {
+        if (!replay_file(argv[i])) failures++;
+    }
+
+    Source src = {NULL, 0, seed};
+    clock_t start = clock();
+    for (long i = 0; i < iterations; i++) {
+        run_case(&src);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Differential test: %ld cases, %llu checks, %llu failures, %llu overflows reported\n",
+           iterations, (unsigned long long)checks, (unsigned long long)failures,
+           (unsigned long long)overflows);
+    printf("Throughput: %.0f cases/s\n", seconds > 0 ? iterations / seconds : 0.0);
+
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
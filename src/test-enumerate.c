@@ -0,0 +1,201 @@
+#include "arbitrary-enumerate.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checks the Gray-code and Heap's-order enumerators: every subset or
+// permutation is visited exactly once, and every delta describes the actual
+// step from the previous one.
+
+#define MAX_SUBSET_N 16
+#define MAX_PERM_N 8
+
+static unsigned char subset_seen[1 << MAX_SUBSET_N];
+
+// Factorial-base rank, so visited permutations fit a flat array
+static int perm_rank(const int* perm, int n) {
+    int rank = 0;
+    for (int i = 0; i < n; i++) {
+        int smaller = 0;
+        for (int j = i + 1; j < n; j++) smaller += perm[j] < perm[i];
+        rank = rank * (n - i) + smaller;
+    }
+    return rank;
+}
+
+static int factorial(int n) {
+    int f = 1;
+    for (int i = 2; i <= n; i++) f *= i;
+    return f;
+}
+
+// === Subsets ===
+
+typedef struct {
+    uint64_t previous;
+    uint64_t visited;
+    bool ok;
+} SubsetWalk;
+
+static bool subset_step_ok(uint64_t previous, uint64_t mask, const ArbitrarySubsetDelta* delta) {
+    return (previous ^ mask) == (UINT64_C(1) << delta->index) &&
+           delta->added == (((mask >> delta->index) & 1) != 0);
+}
+
+void record_subset(uint64_t mask, const ArbitrarySubsetDelta* delta, void* user_data) {
+    SubsetWalk* walk = (SubsetWalk*)user_data;
+    if (!subset_step_ok(walk->previous, mask, delta) || subset_seen[mask]++) walk->ok = false;
+    walk->previous = mask;
+    walk->visited++;
+}
+
+// The callback wrapper visits every non-empty subset once
+bool check_subset_callback(int n) {
+    SubsetWalk walk = {0, 0, true};
+    memset(subset_seen, 0, sizeof(subset_seen));
+    subset_seen[0] = 1;
+    arbitrary_enumerate_subsets(n, record_subset, &walk);
+
+    uint64_t total = UINT64_C(1) << n;
+    if (!walk.ok || walk.visited != total - 1) {
+        printf("subsets n=%d: visited %llu of %llu, steps %s\n", n, (unsigned long long)walk.visited,
+               (unsigned long long)(total - 1), walk.ok ? "valid" : "invalid");
+        return false;
+    }
+    return true;
+}
+
+// Splitting [0, 2^n) into `chunks` iterator ranges covers every subset once
+bool check_subset_ranges(int n, int chunks) {
+    uint64_t total = UINT64_C(1) << n;
+    bool ok = true;
+    memset(subset_seen, 0, sizeof(subset_seen));
+
+    for (int c = 0; c < chunks; c++) {
+        uint64_t begin = total * c / chunks;
+        uint64_t end = total * (c + 1) / chunks;
+        ArbitrarySubsetIter it;
+        ArbitrarySubsetDelta delta;
+        if (!arbitrary_subset_iter_init(&it, n, begin, end)) return false;
+        if (begin == end) continue;
+
+        uint64_t previous = it.mask;
+        ok = ok && it.mask == arbitrary_gray_code(begin) && !subset_seen[it.mask]++;
+        while (arbitrary_subset_iter_next(&it, &delta)) {
+            ok = ok && subset_step_ok(previous, it.mask, &delta) && !subset_seen[it.mask]++;
+            previous = it.mask;
+        }
+        ok = ok && it.rank + 1 == end;
+    }
+    for (uint64_t mask = 0; mask < total; mask++) ok = ok && subset_seen[mask] == 1;
+    if (!ok) printf("subsets n=%d in %d chunks: ranges do not cover every subset once\n", n, chunks);
+    return ok;
+}
+
+// === Permutations ===
+
+typedef struct {
+    int previous[ARBITRARY_PERM_MAX];
+    unsigned char* seen;
+    int visited;
+    bool ok;
+} PermWalk;
+
+void record_permutation(const int* perm, int n, const ArbitraryPermDelta* delta, void* user_data) {
+    PermWalk* walk = (PermWalk*)user_data;
+    if (delta == NULL) {
+        // Only the first permutation comes without a delta, and it is the identity
+        for (int i = 0; i < n; i++) walk->ok = walk->ok && perm[i] == i && walk->visited == 0;
+    } else {
+        int i = delta->i, j = delta->j;
+        walk->ok = walk->ok && i != j && i >= 0 && j >= 0 && i < n && j < n &&
+                   perm[i] == walk->previous[j] && perm[j] == walk->previous[i];
+        for (int p = 0; p < n; p++) {
+            if (p != i && p != j) walk->ok = walk->ok && perm[p] == walk->previous[p];
+        }
+    }
+    if (walk->seen[perm_rank(perm, n)]++) walk->ok = false;
+    memcpy(walk->previous, perm, sizeof(int) * n);
+    walk->visited++;
+}
+
+bool check_permutations(int n) {
+    int total = factorial(n);
+    PermWalk walk = {{0}, calloc(total, 1), 0, true};
+    if (!walk.seen) return false;
+    arbitrary_enumerate_permutations(n, record_permutation, &walk);
+    free(walk.seen);
+
+    if (!walk.ok || walk.visited != total) {
+        printf("permutations n=%d: visited %d of %d, steps %s\n", n, walk.visited, total,
+               walk.ok ? "valid" : "invalid");
+        return false;
+    }
+    return true;
+}
+
+// === Out-of-range sizes ===
+
+void count_subset(uint64_t mask, const ArbitrarySubsetDelta* delta, void* user_data) {
+    (void)mask;
+    (void)delta;
+    (*(int*)user_data)++;
+}
+
+void count_permutation(const int* perm, int n, const ArbitraryPermDelta* delta, void* user_data) {
+    (void)perm;
+    (void)n;
+    (void)delta;
+    (*(int*)user_data)++;
+}
+
+bool check_out_of_range(int n) {
+    ArbitrarySubsetIter subsets;
+    ArbitraryPermIter perms;
+    ArbitrarySubsetDelta subset_delta;
+    ArbitraryPermDelta perm_delta;
+    int calls = 0;
+
+    bool ok = true;
+    if (n < 0 || n > ARBITRARY_SUBSET_MAX) {
+        ok = ok && !arbitrary_subset_iter_init(&subsets, n, 0, UINT64_MAX) &&
+             !arbitrary_subset_iter_next(&subsets, &subset_delta);
+        arbitrary_enumerate_subsets(n, count_subset, &calls);
+    }
+    ok = ok && !arbitrary_perm_iter_init(&perms, n) && !arbitrary_perm_iter_next(&perms, &perm_delta);
+    arbitrary_enumerate_permutations(n, count_permutation, &calls);
+
+    ok = ok && calls == 0;
+    if (!ok) printf("n=%d: out-of-range size was not rejected\n", n);
+    return ok;
+}
+
+int main() {
+    int failures = 0;
+
+    for (int n = 0; n <= MAX_SUBSET_N; n++) {
+        failures += !check_subset_callback(n);
+        failures += !check_subset_ranges(n, 1);
+        failures += !check_subset_ranges(n, 3);
+        failures += !check_subset_ranges(n, 7);
+    }
+    for (int n = 0; n <= MAX_PERM_N; n++) {
+        failures += !check_permutations(n);
+    }
+
+    // An end past 2^n is clamped, and a begin past end leaves nothing to visit
+    ArbitrarySubsetIter it;
+    ArbitrarySubsetDelta delta;
+    arbitrary_subset_iter_init(&it, 3, 0, 100);
+    failures += it.end != 8;
+    arbitrary_subset_iter_init(&it, 3, 6, 2);
+    failures += arbitrary_subset_iter_next(&it, &delta);
+
+    // Sizes the enumerators cannot hold; each rejection prints an error
+    failures += !check_out_of_range(-1);
+    failures += !check_out_of_range(ARBITRARY_PERM_MAX + 1);
+    failures += !check_out_of_range(ARBITRARY_SUBSET_MAX + 1);
+
+    printf("Enumeration: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -1,4 +1,4 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdio.h>
 
 // Inputs and symbolic weights for a 2-input node with bias
@@ -21,10 +21,10 @@ int main() {
     // === Trace output expression ===
     printf("Explainable Inference Trace:\n");
 
-    printf("Input x1 = %lld, Weight w1 = ", x1);
+    printf("Input x1 = %lld, Weight w1 = ", (long long)x1);
     arbitrary_print(w1);
 
-    printf("Input x2 = %lld, Weight w2 = ", x2);
+    printf("Input x2 = %lld, Weight w2 = ", (long long)x2);
     arbitrary_print(w2);
 
     printf("Bias term = ");
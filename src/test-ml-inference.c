@@ -1,4 +1,4 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdio.h>
 
 int main() {
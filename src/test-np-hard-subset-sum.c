@@ -1,20 +1,8 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-
-// Check if two ArbitraryNumbers are exactly equal (all terms equal)
-bool arbitrary_equal(ArbitraryNumber* a, ArbitraryNumber* b) {
-    if (a->length != b->length) return false;
-    for (size_t i = 0; i < a->length; i++) {
-        if (a->terms[i].a != b->terms[i].a ||
-            a->terms[i].b != b->terms[i].b ||
-            a->terms[i].c != b->terms[i].c) {
-            return false;
-        }
-    }
-    return true;
-}
+#include "arbitrary-enumerate.h"
 
 // Print subset indices
 void print_subset(int* subset, int size) {
@@ -40,34 +28,52 @@ int main() {
     ArbitraryNumber* target = arbitrary_create();
     arbitrary_add_term(target, 1, 1, 1); // target = 1 (exact)
 
-    // === Brute force subsets and check sums ===
-    int max_subsets = 1 << n;
+    // === Exact values, so each step is one rational add or subtract ===
+    ArbitraryRational values[4];
+    ArbitraryRational target_value;
+    bool exact = arbitrary_evaluate(target, &target_value);
+    for (int i = 0; exact && i < n; i++) {
+        exact = arbitrary_evaluate(weights[i], &values[i]);
+    }
+    if (!exact) {
+        fprintf(stderr, "Error: weights do not fit in 64-bit rationals.\n");
+        return 1;
+    }
+
+    // === Walk subsets in Gray-code order, updating the sum by the delta ===
+    ArbitrarySubsetIter it;
+    ArbitrarySubsetDelta delta;
+    ArbitraryRational sum = {0, 1};
     int subset[4];
     int subset_size;
     bool found_solution = false;
 
-    for (int mask = 1; mask < max_subsets; mask++) {
-        ArbitraryNumber* sum = arbitrary_create();
-        subset_size = 0;
+    arbitrary_subset_iter_init(&it, n, 0, UINT64_MAX);
+    while (arbitrary_subset_iter_next(&it, &delta)) {
+        bool ok = delta.added ? arbitrary_rational_add(&sum, values[delta.index])
+                              : arbitrary_rational_sub(&sum, values[delta.index]);
+        if (!ok) {
+            fprintf(stderr, "Error: subset sum overflowed 64-bit rationals.\n");
+            return 1;
+        }
 
-        for (int i = 0; i < n; i++) {
-            if (mask & (1 << i)) {
-                subset[subset_size++] = i;
-                ArbitraryNumber* old_sum = sum;
-                sum = arbitrary_add(sum, weights[i]);
-                arbitrary_free(old_sum);
+        if (arbitrary_rational_compare(sum, target_value) == 0) {
+            subset_size = 0;
+            for (int i = 0; i < n; i++) {
+                if (it.mask & (UINT64_C(1) << i)) {
+                    subset[subset_size++] = i;
+                }
             }
-        }
 
-        if (arbitrary_equal(sum, target)) {
+            ArbitraryNumber* exact_sum = arbitrary_create();
+            arbitrary_add_term(exact_sum, 1, sum.num, sum.den);
             printf("Found exact subset sum solution:\n");
             print_subset(subset, subset_size);
             printf("Sum = ");
-            arbitrary_print(sum);
+            arbitrary_print(exact_sum);
+            arbitrary_free(exact_sum);
             found_solution = true;
         }
-
-        arbitrary_free(sum);
     }
 
     if (!found_solution) {
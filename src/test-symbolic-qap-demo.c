@@ -1,57 +1,31 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-#include <string.h>
+#include "arbitrary-solve.h"
 
 #define N 3 // QAP dimension
 
-// === Helper: Compare two arbitrary numbers approximately using doubles ===
-int arbitrary_compare(const ArbitraryNumber* a, const ArbitraryNumber* b) {
-    double da = 0.0, db = 0.0;
-    for (size_t i = 0; i < a->length; i++)
-        da += a->terms[i].c * (double)a->terms[i].a / a->terms[i].b;
-    for (size_t i = 0; i < b->length; i++)
-        db += b->terms[i].c * (double)b->terms[i].a / b->terms[i].b;
-
-    if (da < db) return -1;
-    if (da > db) return 1;
-    return 0;
-}
-
-// === Generate all permutations and apply callback ===
-void generate_permutations(int* perm, bool* used, int depth,
-                           void (*callback)(int*, void*), void* user_data) {
-    if (depth == N) {
-        callback(perm, user_data);
-        return;
-    }
-    for (int i = 0; i < N; i++) {
-        if (!used[i]) {
-            used[i] = true;
-            perm[depth] = i;
-            generate_permutations(perm, used, depth + 1, callback, user_data);
-            used[i] = false;
-        }
-    }
-}
-
 // === Structures ===
 typedef struct {
     ArbitraryNumber* A[N][N];
     ArbitraryNumber* B[N][N];
-    ArbitraryNumber* best_cost;
-    int best_perm[N];
-    bool found;
 } QAPSolver;
 
-// === Cost computation for a given permutation ===
-ArbitraryNumber* compute_cost(QAPSolver* solver, int* perm) {
+// === Symbolic cost of a given permutation ===
+// The search runs on exact rationals with O(N) updates per swap; the
+// symbolic expression is only built once, for the winning permutation.
+// Returns NULL if a term product overflows.
+ArbitraryNumber* compute_cost(QAPSolver* solver, const int* perm) {
     ArbitraryNumber* total = arbitrary_create();
 
     for (int i = 0; i < N; i++) {
         for (int j = 0; j < N; j++) {
             ArbitraryNumber* prod = arbitrary_multiply(solver->A[i][j], solver->B[perm[i]][perm[j]]);
+            if (!prod) {
+                arbitrary_free(total);
+                return NULL;
+            }
             ArbitraryNumber* sum = arbitrary_add(total, prod);
             arbitrary_free(prod);
             arbitrary_free(total);
@@ -61,24 +35,9 @@ ArbitraryNumber* compute_cost(QAPSolver* solver, int* perm) {
     return total;
 }
 
-// === Callback for each permutation ===
-void evaluate_permutation(int* perm, void* user_data) {
-    QAPSolver* solver = (QAPSolver*)user_data;
-    ArbitraryNumber* cost = compute_cost(solver, perm);
-
-    if (!solver->found || arbitrary_compare(cost, solver->best_cost) < 0) {
-        if (solver->found) arbitrary_free(solver->best_cost);
-        solver->best_cost = cost;
-        memcpy(solver->best_perm, perm, sizeof(int) * N);
-        solver->found = true;
-    } else {
-        arbitrary_free(cost);
-    }
-}
-
 // === Main program ===
 int main() {
-    QAPSolver solver = {0};
+    QAPSolver solver;
 
     // === Define Matrix A (flow) with symbolic entries ===
     int A_num[N][N] = {
@@ -116,23 +75,40 @@ int main() {
     }
 
     // === Run permutation search ===
-    int perm[N] = {0};
-    bool used[N] = {false};
+    ArbitraryQAPInstance instance;
+    ArbitrarySolveResult result;
 
     printf("🔢 Solving 3x3 symbolic QAP with arbitrary precision:\n");
-    generate_permutations(perm, used, 0, evaluate_permutation, &solver);
+    if (!arbitrary_qap_instance_init(&instance, N, &solver.A[0][0], &solver.B[0][0]) ||
+        arbitrary_solve_qap(&instance, NULL, &result) == ARBITRARY_SOLVE_OVERFLOW) {
+        fprintf(stderr, "Error: QAP cost overflowed 64-bit rationals.\n");
+        return 1;
+    }
 
     // === Output best result ===
-    if (solver.found) {
+    if (result.found) {
         printf("\n✅ Best permutation: [ ");
         for (int i = 0; i < N; i++) {
-            printf("%d ", solver.best_perm[i]);
+            printf("%d ", result.best_perm[i]);
         }
         printf("]\n");
 
+        ArbitraryNumber* best_cost = compute_cost(&solver, result.best_perm);
+        ArbitraryRational value;
+        if (!best_cost) {
+            fprintf(stderr, "Error: symbolic cost term overflowed 64 bits.\n");
+            return 1;
+        }
         printf("🎯 Exact symbolic cost: ");
-        arbitrary_print(solver.best_cost);
+        arbitrary_print(best_cost);
         printf("\n");
+        if (!arbitrary_evaluate(best_cost, &value) || arbitrary_rational_compare(value, result.best) != 0) {
+            fprintf(stderr, "Error: symbolic cost does not match the solver's exact cost.\n");
+            arbitrary_free(best_cost);
+            return 1;
+        }
+        printf("   = %lld/%lld\n", (long long)value.num, (long long)value.den);
+        arbitrary_free(best_cost);
     } else {
         printf("No solution found.\n");
     }
@@ -144,7 +120,6 @@ int main() {
             arbitrary_free(solver.B[i][j]);
         }
     }
-    if (solver.best_cost) arbitrary_free(solver.best_cost);
 
     return 0;
 }
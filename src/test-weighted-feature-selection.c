@@ -1,24 +1,12 @@
-#include "arbitrary_number.h"
+#include "arbitrary-number.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "arbitrary-filter.h"
 
 #define MAX_FEATURES 16  // Keep small for brute force demo
 
-// Check exact equality of two ArbitraryNumbers (terms must match)
-bool arbitrary_equal(ArbitraryNumber* a, ArbitraryNumber* b) {
-    if (a->length != b->length) return false;
-    for (size_t i = 0; i < a->length; i++) {
-        if (a->terms[i].a != b->terms[i].a ||
-            a->terms[i].b != b->terms[i].b ||
-            a->terms[i].c != b->terms[i].c) {
-            return false;
-        }
-    }
-    return true;
-}
-
 // Print indices of selected features
 void print_selected_features(int* selected, int count) {
     printf("{ ");
@@ -28,10 +16,38 @@ void print_selected_features(int* selected, int count) {
     printf("}\n");
 }
 
+// Stream callback for exact matches coming out of the filter pipeline
+void report_match(uint64_t mask, const ArbitraryRational* sum, void* user_data) {
+    int n_features = *(int*)user_data;
+    int selected_indices[MAX_FEATURES];
+    int selected_count = 0;
+
+    for (int f = 0; f < n_features; f++) {
+        if (mask & (UINT64_C(1) << f)) {
+            selected_indices[selected_count++] = f;
+        }
+    }
+
+    if (!sum) {
+        // Passed the approximate stage, but its exact sum overflowed 64 bits
+        printf("Undecided subset (exact sum overflowed): ");
+        print_selected_features(selected_indices, selected_count);
+        return;
+    }
+
+    ArbitraryNumber* exact_sum = arbitrary_create();
+    arbitrary_add_term(exact_sum, 1, sum->num, sum->den);
+    printf("Found exact matching subset: ");
+    print_selected_features(selected_indices, selected_count);
+    printf("Sum = ");
+    arbitrary_print(exact_sum);
+    arbitrary_free(exact_sum);
+}
+
 int main() {
     // === Example feature weights (symbolic) ===
     // Representing feature importance or contribution to output
-    const int n_features = 6;
+    int n_features = 6;
     ArbitraryNumber* feature_weights[MAX_FEATURES];
 
     // Initialize some sample fractional weights
@@ -49,43 +65,27 @@ int main() {
     // Let's set target as 1 (exact)
     arbitrary_add_term(target, 1, 1, 1);
 
-    // === Brute force search for subsets whose sum equals target ===
-    int max_subsets = 1 << n_features;
-    int selected_indices[MAX_FEATURES];
-    int selected_count;
-    bool found_any = false;
-
     printf("Weighted Feature Selection - searching subsets that sum to target = ");
     arbitrary_print(target);
     printf("\n");
 
-    for (int subset_mask = 1; subset_mask < max_subsets; subset_mask++) {
-        ArbitraryNumber* subset_sum = arbitrary_create();
-        selected_count = 0;
-
-        for (int f = 0; f < n_features; f++) {
-            if (subset_mask & (1 << f)) {
-                selected_indices[selected_count++] = f;
-                ArbitraryNumber* old_sum = subset_sum;
-                subset_sum = arbitrary_add(subset_sum, feature_weights[f]);
-                arbitrary_free(old_sum);
-            }
-        }
-
-        if (arbitrary_equal(subset_sum, target)) {
-            printf("Found exact matching subset: ");
-            print_selected_features(selected_indices, selected_count);
-            printf("Sum = ");
-            arbitrary_print(subset_sum);
-            found_any = true;
-        }
+    // === Approximate filter first, exact comparison only inside the error band ===
+    ArbitraryFilterStats stats;
+    ArbitraryMatchFilter* filter = arbitrary_filter_create(feature_weights, n_features, target, NULL);
+    if (!filter) return 1;
 
-        arbitrary_free(subset_sum);
-    }
+    arbitrary_filter_run(filter, report_match, &n_features, &stats);
+    arbitrary_filter_free(filter);
 
-    if (!found_any) {
+    if (stats.overflows > 0) {
+        printf("Result incomplete: %llu candidate subsets overflowed and could not be checked.\n",
+               (unsigned long long)stats.overflows);
+    } else if (stats.matches == 0) {
         printf("No exact matching subset found.\n");
     }
+    printf("Scanned %llu subsets, %llu checked exactly, %llu matched, %llu undecided.\n",
+           (unsigned long long)stats.candidates, (unsigned long long)stats.passed,
+           (unsigned long long)stats.matches, (unsigned long long)stats.overflows);
 
     // Cleanup
     for (int i = 0; i < n_features; i++) {